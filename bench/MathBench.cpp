@@ -0,0 +1,128 @@
+// Math micro-benchmark. Built once per MELKAM_SIMD backend (MathBench_SCALAR, MathBench_SSE4,
+// MathBench_AVX2); run them back to back with the bench_math target and compare the columns.
+
+#include <Melkam/math/Math.hpp>
+#include <Melkam/math/SimdKernels.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Melkam;
+
+namespace
+{
+    constexpr std::size_t Count = 4096;
+    constexpr int Rounds = 200;
+
+    // Keeps results alive so the optimiser cannot drop the work.
+    volatile float g_sink = 0.0f;
+
+    template <typename Func>
+    void measure(const char *name, std::size_t opsPerRound, Func &&func)
+    {
+        func();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < Rounds; ++round)
+        {
+            func();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("  %-22s %8.2f ns/op\n", name, ns / (static_cast<double>(opsPerRound) * Rounds));
+    }
+}
+
+int main()
+{
+    std::vector<Matrix4f> matrices(Count);
+    std::vector<Quaternionf> rotations(Count);
+    std::vector<Vector3f> points(Count);
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        const float f = static_cast<float>(i);
+        const Vector3f euler{f * 0.001f, f * 0.002f, f * 0.003f};
+        matrices[i] = Matrix4f::compose({f, -f, f * 0.5f}, euler, {1.0f, 2.0f, 0.5f});
+        rotations[i] = Quaternionf::fromEuler(euler);
+        points[i] = {f, f * 0.25f, -f};
+    }
+
+    std::vector<Matrix4f> outMatrices(Count);
+    std::vector<Quaternionf> outRotations(Count);
+    std::vector<Vector3f> outPoints(Count);
+
+    std::printf("Melkam math (%s)\n", SimdBackendName());
+
+    measure("mat4 multiply", Count,
+            [&]()
+            {
+                for (std::size_t i = 0; i + 1 < Count; ++i)
+                {
+                    outMatrices[i] = matrices[i] * matrices[i + 1];
+                }
+                g_sink = outMatrices[Count / 2].m[5];
+            });
+
+    measure("mat4 inverse", Count,
+            [&]()
+            {
+                for (std::size_t i = 0; i < Count; ++i)
+                {
+                    outMatrices[i] = matrices[i].inverse();
+                }
+                g_sink = outMatrices[Count / 2].m[5];
+            });
+
+    measure("mat4 compose (quat)", Count,
+            [&]()
+            {
+                for (std::size_t i = 0; i < Count; ++i)
+                {
+                    outMatrices[i] = Matrix4f::compose(points[i], rotations[i], {1.0f, 1.0f, 1.0f});
+                }
+                g_sink = outMatrices[Count / 2].m[5];
+            });
+
+    measure("mat4 decompose", Count,
+            [&]()
+            {
+                Vector3f translation;
+                Vector3f scale;
+                for (std::size_t i = 0; i < Count; ++i)
+                {
+                    matrices[i].decompose(translation, outRotations[i], scale);
+                }
+                g_sink = outRotations[Count / 2].w;
+            });
+
+    measure("quat multiply", Count,
+            [&]()
+            {
+                for (std::size_t i = 0; i + 1 < Count; ++i)
+                {
+                    outRotations[i] = rotations[i] * rotations[i + 1];
+                }
+                g_sink = outRotations[Count / 2].w;
+            });
+
+    measure("quat slerp", Count,
+            [&]()
+            {
+                for (std::size_t i = 0; i + 1 < Count; ++i)
+                {
+                    outRotations[i] = Quaternionf::slerp(rotations[i], rotations[i + 1], 0.3f);
+                }
+                g_sink = outRotations[Count / 2].w;
+            });
+
+    measure("vec3 transform (batch)", Count,
+            [&]()
+            {
+                TransformPoints(matrices[7], points.data(), outPoints.data(), Count);
+                g_sink = outPoints[Count / 2].y;
+            });
+
+    return 0;
+}
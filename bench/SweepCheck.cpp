@@ -0,0 +1,157 @@
+// Backend check for SweepAabbBatch. Built once per MELKAM_SIMD backend (SweepCheck_SCALAR,
+// SweepCheck_SSE4, SweepCheck_AVX2): the scalar build writes its results for a fixed random set of
+// sweeps to the file named on the command line, and the vector builds compare theirs against that
+// file bit for bit. The check_sweep target runs them in that order.
+
+#include <Melkam/math/SimdKernels.hpp>
+#include <Melkam/physics/SweepBatch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Melkam;
+
+namespace
+{
+    constexpr int Cases = 2000;
+    constexpr std::size_t MaxCandidates = 67;
+
+    // Fixed LCG, so every build sweeps the same boxes whatever its standard library.
+    struct Random
+    {
+        std::uint32_t state = 12345u;
+
+        std::uint32_t next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        }
+
+        // Quarter-unit grid, so faces touch and times tie often.
+        float coord(int range)
+        {
+            return static_cast<float>(static_cast<int>(next() % static_cast<std::uint32_t>(range * 8)) - range * 4) * 0.25f;
+        }
+
+        float extent()
+        {
+            return static_cast<float>(1 + next() % 12) * 0.25f;
+        }
+    };
+
+    std::uint32_t bits(float value)
+    {
+        std::uint32_t out;
+        std::memcpy(&out, &value, sizeof(out));
+        return out;
+    }
+
+    std::string describe(const SweepHit &hit)
+    {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%d %zu %08x %08x %08x %08x\n", hit.hit ? 1 : 0, hit.index, bits(hit.time),
+                      bits(hit.normal[0]), bits(hit.normal[1]), bits(hit.normal[2]));
+        return line;
+    }
+
+    // Ids are shuffled against the candidate order, so ties exercise the lower-id rule.
+    EntityId candidateId(Random &random, std::size_t index)
+    {
+        return MakeEntityId(static_cast<std::uint32_t>(1 + (index * 37 + random.next() % 5) % 101), 1u);
+    }
+
+    std::vector<std::string> run()
+    {
+        Random random;
+        std::vector<std::string> results;
+        SweepCandidates2D candidates2D;
+        SweepCandidates3D candidates3D;
+        for (int i = 0; i < Cases; ++i)
+        {
+            const std::size_t count = random.next() % (MaxCandidates + 1);
+            const float x = random.coord(4);
+            const float y = random.coord(4);
+            const float z = random.coord(4);
+            const float ex = random.extent();
+            const float ey = random.extent();
+            const float ez = random.extent();
+            // One axis in three stays still, to cover the zero-motion branch.
+            const float dx = random.next() % 3 == 0 ? 0.0f : random.coord(6);
+            const float dy = random.next() % 3 == 0 ? 0.0f : random.coord(6);
+            const float dz = random.next() % 3 == 0 ? 0.0f : random.coord(6);
+
+            candidates2D.clear();
+            candidates3D.clear();
+            for (std::size_t c = 0; c < count; ++c)
+            {
+                const float cx = random.coord(6);
+                const float cy = random.coord(6);
+                const float cz = random.coord(6);
+                const float hx = random.extent();
+                const float hy = random.extent();
+                const float hz = random.extent();
+                const EntityId id = candidateId(random, c);
+                candidates2D.push(id, {cx - hx, cy - hy, cx + hx, cy + hy});
+                candidates3D.push(id, {cx - hx, cy - hy, cz - hz, cx + hx, cy + hy, cz + hz});
+            }
+
+            results.push_back(describe(SweepAabbBatch(Aabb2D{x - ex, y - ey, x + ex, y + ey}, dx, dy, candidates2D)));
+            results.push_back(describe(SweepAabbBatch(Aabb3D{x - ex, y - ey, z - ez, x + ex, y + ey, z + ez}, dx, dy, dz, candidates3D)));
+        }
+        return results;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s <reference file>\n", argv[0]);
+        return 2;
+    }
+
+    const std::vector<std::string> results = run();
+
+#if !defined(MELKAM_SIMD_AVX2) && !defined(MELKAM_SIMD_SSE4)
+    std::FILE *file = std::fopen(argv[1], "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    for (const std::string &line : results)
+    {
+        std::fputs(line.c_str(), file);
+    }
+    std::fclose(file);
+    std::printf("SweepAabbBatch (%s): wrote %zu reference sweeps\n", SimdBackendName(), results.size());
+    return 0;
+#else
+    std::FILE *file = std::fopen(argv[1], "r");
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot read %s; run the scalar build first\n", argv[1]);
+        return 1;
+    }
+
+    std::size_t mismatches = 0;
+    char line[96];
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!std::fgets(line, sizeof(line), file) || results[i] != line)
+        {
+            if (++mismatches <= 10)
+            {
+                std::fprintf(stderr, "sweep %zu (%s): got %s", i / 2, i % 2 == 0 ? "2D" : "3D", results[i].c_str());
+            }
+        }
+    }
+    std::fclose(file);
+
+    std::printf("SweepAabbBatch (%s): %zu of %zu sweeps differ from scalar\n", SimdBackendName(), mismatches, results.size());
+    return mismatches == 0 ? 0 : 1;
+#endif
+}
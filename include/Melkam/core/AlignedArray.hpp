@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Melkam
+{
+    // Growable array of trivially copyable values whose storage starts on an Alignment-byte
+    // boundary, for SIMD loads and stores.
+    template <typename T, std::size_t Alignment = 32>
+    class AlignedArray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "AlignedArray only holds trivially copyable types");
+
+    public:
+        AlignedArray() = default;
+
+        ~AlignedArray()
+        {
+            release();
+        }
+
+        AlignedArray(const AlignedArray &) = delete;
+        AlignedArray &operator=(const AlignedArray &) = delete;
+
+        AlignedArray(AlignedArray &&other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)),
+              m_size(std::exchange(other.m_size, 0)),
+              m_capacity(std::exchange(other.m_capacity, 0))
+        {
+        }
+
+        AlignedArray &operator=(AlignedArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+            }
+            return *this;
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            if (capacity <= m_capacity)
+            {
+                return;
+            }
+
+            T *data = static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t(Alignment)));
+            if (m_size > 0)
+            {
+                std::memcpy(data, m_data, m_size * sizeof(T));
+            }
+            release();
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        // New elements are value-initialised.
+        void resize(std::size_t size)
+        {
+            if (size > m_capacity)
+            {
+                reserve(std::max(size, m_capacity * 2));
+            }
+            for (std::size_t i = m_size; i < size; ++i)
+            {
+                m_data[i] = T{};
+            }
+            m_size = size;
+        }
+
+        void push_back(const T &value)
+        {
+            if (m_size == m_capacity)
+            {
+                reserve(m_capacity == 0 ? 64 : m_capacity * 2);
+            }
+            m_data[m_size++] = value;
+        }
+
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        T *data()
+        {
+            return m_data;
+        }
+
+        const T *data() const
+        {
+            return m_data;
+        }
+
+        T &operator[](std::size_t index)
+        {
+            return m_data[index];
+        }
+
+        const T &operator[](std::size_t index) const
+        {
+            return m_data[index];
+        }
+
+    private:
+        void release()
+        {
+            if (m_data)
+            {
+                ::operator delete(m_data, std::align_val_t(Alignment));
+                m_data = nullptr;
+            }
+            m_capacity = 0;
+        }
+
+        T *m_data = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_capacity = 0;
+    };
+}
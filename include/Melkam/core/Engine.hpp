@@ -6,6 +6,7 @@
 namespace Melkam
 {
     class Scene;
+    class ThreadPool;
 }
 
 namespace Melkam
@@ -28,6 +29,8 @@ namespace Melkam
         bool borderless = false;
         bool vsync = false;
         bool highDpi = false;
+        // Worker threads for scene systems; -1 picks hardware threads minus one, 0 keeps everything on the main thread.
+        int workerThreads = -1;
     };
 
     class Engine
@@ -60,11 +63,13 @@ namespace Melkam
     private:
         void init();
         void cleanup();
+        void attachScene(const std::shared_ptr<Scene>& scene);
         
         EngineConfig m_config;
         EngineState m_state;
 
         std::unique_ptr<Window> m_window;
+        std::unique_ptr<ThreadPool> m_threadPool;
         std::shared_ptr<Scene> m_activeScene;
         std::shared_ptr<Scene> m_pendingScene;
         bool m_reloadRequested = false;
@@ -0,0 +1,92 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Melkam
+{
+    // Work-stealing pool: each worker pops from the back of its own queue and steals from
+    // the front of the others. Threads that wait on a TaskGroup run queued tasks meanwhile.
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // Counts the unfinished tasks of one batch.
+        class TaskGroup
+        {
+        public:
+            bool done() const
+            {
+                return m_pending.load(std::memory_order_acquire) == 0;
+            }
+
+        private:
+            friend class ThreadPool;
+            std::atomic<std::size_t> m_pending{0};
+        };
+
+        // workerCount 0 keeps the pool thread-less: tasks run inside wait() on the caller.
+        explicit ThreadPool(std::size_t workerCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        std::size_t workerCount() const;
+
+        void submit(TaskGroup &group, Task task);
+        void wait(TaskGroup &group);
+
+        // Calls func(begin, end) for consecutive chunks of [0, count). Chunk boundaries depend
+        // only on count and chunkSize, never on the number of workers.
+        template <typename Func>
+        void parallelFor(std::size_t count, std::size_t chunkSize, Func &&func)
+        {
+            TaskGroup group;
+            for (std::size_t begin = 0; begin < count; begin += chunkSize)
+            {
+                const std::size_t end = std::min(count, begin + chunkSize);
+                submit(group, [&func, begin, end]()
+                       { func(begin, end); });
+            }
+            wait(group);
+        }
+
+        // Hardware threads minus the main thread, at least 0.
+        static std::size_t defaultWorkerCount();
+
+    private:
+        struct Entry
+        {
+            Task task;
+            TaskGroup *group = nullptr;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Entry> entries;
+        };
+
+        bool runOne(std::size_t home);
+        bool popBack(Queue &queue, Entry &out);
+        bool stealFront(Queue &queue, Entry &out);
+        void workerLoop(std::size_t index);
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+        std::atomic<std::size_t> m_queued{0};
+        std::atomic<std::size_t> m_nextQueue{0};
+        bool m_stopping = false;
+    };
+}
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <cstddef>
+
+#include <Melkam/math/Quaternion.hpp>
+#include <Melkam/math/Vector.hpp>
+
 namespace Melkam
 {
-    struct Matrix4f
+    // Column-major, column vectors: element (row, col) is m[col * 4 + row], translation is m[12..14].
+    // Multiply, inverse and batch transforms use the SIMD backend chosen by MELKAM_SIMD.
+    struct alignas(16) Matrix4f
     {
         float m[16] = {
             1.0f, 0.0f, 0.0f, 0.0f,
@@ -11,5 +18,33 @@ namespace Melkam
             0.0f, 0.0f, 0.0f, 1.0f};
 
         static Matrix4f identity() { return Matrix4f{}; }
+
+        // T * R * S, with R built from Euler angles in radians as Ry * Rx * Rz.
+        static Matrix4f compose(const Vector3f &translation, const Vector3f &rotation, const Vector3f &scale);
+        static Matrix4f compose(const Vector3f &translation, const Quaternionf &rotation, const Vector3f &scale);
+
+        // Splits a T * R * S matrix back into its parts. Returns false when a scale axis is zero;
+        // a negative determinant is folded into scale.x.
+        bool decompose(Vector3f &translation, Quaternionf &rotation, Vector3f &scale) const;
+
+        Matrix4f operator*(const Matrix4f &other) const;
+
+        // General inverse; returns identity for a singular matrix.
+        Matrix4f inverse() const;
+        Matrix4f transposed() const;
+
+        // w = 1 for points, w = 0 for directions. No perspective divide.
+        Vector3f transformPoint(const Vector3f &point) const;
+        Vector3f transformVector(const Vector3f &vector) const;
+
+        Vector3f translation() const { return {m[12], m[13], m[14]}; }
     };
+
+    inline Vector3f operator*(const Matrix4f &matrix, const Vector3f &point)
+    {
+        return matrix.transformPoint(point);
+    }
+
+    // out[i] = matrix.transformPoint(in[i]); in and out may alias.
+    void TransformPoints(const Matrix4f &matrix, const Vector3f *in, Vector3f *out, std::size_t count);
 }
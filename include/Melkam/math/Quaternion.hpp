@@ -1,8 +1,10 @@
 #pragma once
 
+#include <Melkam/math/Vector.hpp>
+
 namespace Melkam
 {
-    struct Quaternionf
+    struct alignas(16) Quaternionf
     {
         float x = 0.0f;
         float y = 0.0f;
@@ -16,5 +18,29 @@ namespace Melkam
         }
 
         static Quaternionf identity() { return Quaternionf{}; }
+
+        // axis must be normalised.
+        static Quaternionf fromAxisAngle(const Vector3f &axis, float radians);
+
+        // Same convention as Matrix4f::compose: Ry * Rx * Rz, radians.
+        static Quaternionf fromEuler(const Vector3f &radians);
+
+        // Shortest-arc spherical interpolation; falls back to nlerp for nearly parallel inputs.
+        static Quaternionf slerp(const Quaternionf &from, const Quaternionf &to, float t);
+
+        // Hamilton product: (a * b) rotates by b first, then a.
+        Quaternionf operator*(const Quaternionf &other) const;
+
+        Vector3f rotate(const Vector3f &vector) const;
+
+        float dot(const Quaternionf &other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+        float length() const;
+        Quaternionf normalized() const;
+        Quaternionf conjugate() const { return {-x, -y, -z, w}; }
     };
+
+    inline Vector3f operator*(const Quaternionf &rotation, const Vector3f &vector)
+    {
+        return rotation.rotate(vector);
+    }
 }
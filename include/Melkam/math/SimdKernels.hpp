@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+
+namespace Melkam
+{
+    // Batch kernels over float arrays. The backend (AVX2, SSE4 or scalar) is fixed at compile
+    // time by MELKAM_SIMD; every backend returns bit-identical results.
+
+    // position[i] += velocity[i] * dt
+    void IntegrateAxis(float *position, const float *velocity, std::size_t count, float dt);
+
+    // outMin[i] = center[i] - half[i], outMax[i] = center[i] + half[i]
+    void BuildBounds(const float *center, const float *half, float *outMin, float *outMax, std::size_t count);
+
+    const char *SimdBackendName();
+}
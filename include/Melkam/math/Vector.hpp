@@ -112,6 +112,13 @@ namespace Melkam
             const float len = length();
             return len > 0.0f ? Vector3f{x / len, y / len, z / len} : Vector3f{};
         }
+
+        float dot(const Vector3f &other) const { return x * other.x + y * other.y + z * other.z; }
+
+        Vector3f cross(const Vector3f &other) const
+        {
+            return {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
+        }
     };
 
     struct Vector2i
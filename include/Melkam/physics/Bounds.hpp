@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <Melkam/scene/Components.hpp>
+
+namespace Melkam
+{
+    class Entity;
+
+    struct Aabb2D
+    {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+    };
+
+    struct Aabb3D
+    {
+        float minX;
+        float minY;
+        float minZ;
+        float maxX;
+        float maxY;
+        float maxZ;
+    };
+
+    inline bool Intersects(const Aabb2D &a, const Aabb2D &b)
+    {
+        return a.minX < b.maxX && a.maxX > b.minX && a.minY < b.maxY && a.maxY > b.minY;
+    }
+
+    inline bool Intersects(const Aabb3D &a, const Aabb3D &b)
+    {
+        return a.minX < b.maxX && a.maxX > b.minX && a.minY < b.maxY && a.maxY > b.minY && a.minZ < b.maxZ && a.maxZ > b.minZ;
+    }
+
+    // Touching counts; broadphases use this so a sweep that ends exactly on a face is not culled.
+    inline bool Overlaps(const Aabb2D &a, const Aabb2D &b)
+    {
+        return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY;
+    }
+
+    inline bool Overlaps(const Aabb3D &a, const Aabb3D &b)
+    {
+        return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY && a.minZ <= b.maxZ && a.maxZ >= b.minZ;
+    }
+
+    // Box covering `box` over the whole motion.
+    inline Aabb2D SweptAabb(const Aabb2D &box, float dx, float dy)
+    {
+        return {box.minX + std::min(dx, 0.0f), box.minY + std::min(dy, 0.0f),
+                box.maxX + std::max(dx, 0.0f), box.maxY + std::max(dy, 0.0f)};
+    }
+
+    inline Aabb3D SweptAabb(const Aabb3D &box, float dx, float dy, float dz)
+    {
+        return {box.minX + std::min(dx, 0.0f), box.minY + std::min(dy, 0.0f), box.minZ + std::min(dz, 0.0f),
+                box.maxX + std::max(dx, 0.0f), box.maxY + std::max(dy, 0.0f), box.maxZ + std::max(dz, 0.0f)};
+    }
+
+    // A local-space box placed at origin.
+    inline Aabb3D OffsetAabb(const Aabb3D &local, const Vector3f &origin)
+    {
+        return {local.minX + origin.x, local.minY + origin.y, local.minZ + origin.z,
+                local.maxX + origin.x, local.maxY + origin.y, local.maxZ + origin.z};
+    }
+
+    // Narrows [enter, exit] to the times in [0, 1] at which an interval [boxMin, boxMax] moving by
+    // d touches [targetMin, targetMax]. False once the range is empty.
+    inline bool SweepInterval(float boxMin, float boxMax, float d, float targetMin, float targetMax, float &enter, float &exit)
+    {
+        const float lo = targetMin - boxMax;
+        const float hi = targetMax - boxMin;
+        if (d == 0.0f)
+        {
+            return lo <= 0.0f && hi >= 0.0f && enter <= exit;
+        }
+
+        const float t0 = lo / d;
+        const float t1 = hi / d;
+        enter = std::max(enter, std::min(t0, t1));
+        exit = std::min(exit, std::max(t0, t1));
+        return enter <= exit;
+    }
+
+    // Whether box touches target anywhere along a move by motion (z is ignored in 2D). Touching
+    // counts, like Overlaps; broadphases use this to prune ray and shape casts.
+    inline bool SweepTouches(const Aabb2D &box, const float motion[3], const Aabb2D &target)
+    {
+        float enter = 0.0f;
+        float exit = 1.0f;
+        return SweepInterval(box.minX, box.maxX, motion[0], target.minX, target.maxX, enter, exit) &&
+               SweepInterval(box.minY, box.maxY, motion[1], target.minY, target.maxY, enter, exit);
+    }
+
+    inline bool SweepTouches(const Aabb3D &box, const float motion[3], const Aabb3D &target)
+    {
+        float enter = 0.0f;
+        float exit = 1.0f;
+        return SweepInterval(box.minX, box.maxX, motion[0], target.minX, target.maxX, enter, exit) &&
+               SweepInterval(box.minY, box.maxY, motion[1], target.minY, target.maxY, enter, exit) &&
+               SweepInterval(box.minZ, box.maxZ, motion[2], target.minZ, target.maxZ, enter, exit);
+    }
+
+    // Entities without a CollisionLayerComponent sit on layer 1 and collide with everything.
+    inline std::uint32_t LayerBits(const CollisionLayerComponent *layers)
+    {
+        return layers ? layers->layer : 1u;
+    }
+
+    inline std::uint32_t MaskBits(const CollisionLayerComponent *layers)
+    {
+        return layers ? layers->mask : 0xFFFFFFFFu;
+    }
+
+    inline bool LayersCollide(std::uint32_t aLayer, std::uint32_t aMask, std::uint32_t bLayer, std::uint32_t bMask)
+    {
+        return (aMask & bLayer) != 0u && (bMask & aLayer) != 0u;
+    }
+
+    // StaticBody, StaticBody2D or StaticBody3D: baked into the static BVHs and never moved by physics.
+    bool IsStaticBody(const Entity &entity);
+
+    // Triggers and areas: reported by area signals but never blocking movement.
+    bool IsTriggerLike(const Entity &entity, const ColliderComponent *collider);
+
+    // Where localPosition lands in world space: through the parent's WorldTransformComponent, as
+    // of the last Scene::updateWorldTransforms(), so a body moved since then is placed where it
+    // is now. Roots return it unchanged.
+    Vector3f WorldPosition(const Entity &entity, const Vector3f &localPosition);
+
+    // World-space bounds of the entity's 2D/3D shape at `transform`, placed by WorldPosition();
+    // shapes never rotate or scale. False when it has no supported shape. Negative sizes and
+    // radii count by their magnitude. A CollisionMeshComponent counts once its PhysicsWorld proxy
+    // has resolved the cooked mesh.
+    bool ComputeAabb2D(const Entity &entity, const TransformComponent &transform, Aabb2D &out);
+    bool ComputeAabb3D(const Entity &entity, const TransformComponent &transform, Aabb3D &out);
+}
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <functional>
+#include <vector>
 
+#include <Melkam/physics/PhysicsEvents.hpp>
 #include <Melkam/scene/Components.hpp>
 
 namespace Melkam
@@ -9,21 +10,42 @@ namespace Melkam
     class Scene;
     class Entity;
 
-    struct CollisionInfo
+    void RegisterColliderSystems(Scene &scene);
+    // Creates the scene's PhysicsWorld and adds the main-thread system that fires signals the
+    // physics systems queued. Register2DSystems and RegisterColliderSystems add it after their
+    // physics systems; register systems that pass SignalDelivery::Deferred before it so their
+    // signals still fire in the same frame.
+    void RegisterPhysicsSignalSystem(Scene &scene);
+
+    // Immediate fires the queued signals before the move function returns. Deferred leaves them to
+    // the signal system, for callers on a worker thread whose callbacks could race other systems.
+    enum class SignalDelivery
     {
-        bool hit = false;
-        EntityId collider = InvalidEntity;
-        float normal[3] = {0.0f, 0.0f, 0.0f};
-        float travel = 0.0f;
+        Immediate,
+        Deferred
     };
 
-    using CollisionCallback = std::function<void(Entity self, Entity other, const CollisionInfo &info)>;
-    using AreaCallback = std::function<void(Entity area, Entity body)>;
-
-    void RegisterColliderSystems(Scene &scene);
     void SetSlideSettings(float epsilon, int maxSlides);
+    // Colliders sit at their world position, but moves add the world-space motion to the local
+    // TransformComponent position, so a moving body's parents should only translate it.
     bool MoveAndSlide2D(Entity &entity, float dt);
     bool MoveAndSlide3D(Entity &entity, float dt);
+    // MoveAndSlide2D/3D for every CharacterBody2D/3D entity with a velocity, transform and
+    // collider, spread over the scene's thread pool. Bodies slide against the broadphase as it
+    // was before the call, so they do not see each other's moves this step, and the result does
+    // not depend on the thread count. Collision signals fire after all bodies moved, in view
+    // order. The calling system must declare write access to transforms, velocities and colliders,
+    // and read access to nodes and world transforms.
+    void MoveAndSlideCharacters2D(Scene &scene, float dt, SignalDelivery delivery = SignalDelivery::Immediate);
+    void MoveAndSlideCharacters3D(Scene &scene, float dt, SignalDelivery delivery = SignalDelivery::Immediate);
+    // The same for an explicit list; entities without a velocity, transform and collider of the
+    // matching dimension are skipped. Duplicates are not allowed. In 2D, a BoxShape2D entity
+    // without a collider also slides, as Physics2DSystem movers did before 2D colliders; it has no
+    // proxy, so nothing is blocked by it.
+    void MoveAndSlideBatch2D(Scene &scene, const std::vector<EntityId> &entities, float dt,
+                             SignalDelivery delivery = SignalDelivery::Immediate);
+    void MoveAndSlideBatch3D(Scene &scene, const std::vector<EntityId> &entities, float dt,
+                             SignalDelivery delivery = SignalDelivery::Immediate);
     bool MoveAndCollide2D(Entity &entity, const float motion[2], float dt);
     bool MoveAndCollide3D(Entity &entity, const float motion[3], float dt);
     bool MoveAndCollide2D(Entity &entity, const float motion[2], float dt, CollisionInfo &outInfo);
@@ -32,8 +54,21 @@ namespace Melkam
     bool IsOnWall(const Entity &entity);
     bool IsOnCeiling(const Entity &entity);
     void GetFloorNormal(const Entity &entity, float outNormal[3]);
+    // Rigid bodies are stepped by the system RegisterColliderSystems adds and fall asleep once
+    // they settle. Sleepers wake on contact, when their velocity is set, or when a collider they
+    // rest on is removed; wake them by hand after moving something they rest on.
+    void WakeRigidBody(const Entity &entity);
+    bool IsRigidBodySleeping(const Entity &entity);
 
+    // Signals are queued on the entity's scene while bodies move and fire, in the order the hits
+    // or overlaps were found, once the move function is done or, for deferred moves and the area
+    // system, when the signal system runs on the main thread.
     void ConnectCollisionSignal(Entity entity, CollisionCallback callback);
     void ConnectAreaBodyEntered(Entity area, AreaCallback callback);
     void ConnectAreaBodyExited(Entity area, AreaCallback callback);
+    // Listeners receive every event of their type in the scene as one batch per dispatch, before
+    // the per-entity signals fire.
+    void ListenCollisions(Scene &scene, CollisionListener listener);
+    void ListenAreaBodyEntered(Scene &scene, AreaListener listener);
+    void ListenAreaBodyExited(Scene &scene, AreaListener listener);
 }
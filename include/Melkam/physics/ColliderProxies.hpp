@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    class Scene;
+    class Entity;
+    class CollisionMesh;
+
+    enum class ShapeKind : std::uint8_t
+    {
+        Box2D,
+        Circle2D,
+        Box3D,
+        Sphere3D,
+        Mesh3D
+    };
+
+    // Everything the broadphases and pair loops need about one collider, read from its
+    // components once so they never look components up per candidate.
+    struct ColliderProxy
+    {
+        static constexpr std::uint8_t Is2D = 1u << 0;
+        static constexpr std::uint8_t Trigger = 1u << 1;
+        static constexpr std::uint8_t Area = 1u << 2;
+        static constexpr std::uint8_t Static = 1u << 3;
+        static constexpr std::uint8_t Bare = 1u << 4;
+
+        // 2D colliders leave z at 0.
+        Aabb3D bounds;
+        EntityId id;
+        std::uint32_t layer;
+        std::uint32_t mask;
+        ShapeKind shape;
+        std::uint8_t flags;
+
+        bool is2D() const
+        {
+            return (flags & Is2D) != 0u;
+        }
+
+        // ColliderComponent::isTrigger.
+        bool isTrigger() const
+        {
+            return (flags & Trigger) != 0u;
+        }
+
+        // Has the Area2D/Area3D component of its dimension.
+        bool isArea() const
+        {
+            return (flags & Area) != 0u;
+        }
+
+        bool isStatic() const
+        {
+            return (flags & Static) != 0u;
+        }
+
+        // A BoxShape2D StaticBody wall without a ColliderComponent, as 2D scenes were built before
+        // they had colliders. It blocks movers but is not a body for area signals.
+        bool isBare() const
+        {
+            return (flags & Bare) != 0u;
+        }
+
+        // Triggers and areas, which movers pass through.
+        bool isTriggerLike() const
+        {
+            return (flags & (Trigger | Area)) != 0u;
+        }
+
+        Aabb2D bounds2D() const
+        {
+            return {bounds.minX, bounds.minY, bounds.maxX, bounds.maxY};
+        }
+    };
+
+    // A CollisionMeshComponent's cooked mesh, placed at its world position. Concave meshes collide
+    // by their triangles, convex ones by the mesh's bounds.
+    struct MeshShape
+    {
+        const CollisionMesh *mesh;
+        float origin[3];
+        bool concave;
+    };
+
+    // Flat array of collider proxies with an EntityIndex lookup. Colliders without a transform or
+    // a supported shape have no proxy; bare 2D walls (see isBare()) get one without a collider.
+    class ColliderProxies
+    {
+    public:
+        // Brings the proxies up to date with the scene. Only rebuilds when a collider, transform,
+        // shape, body or area component was added or removed since the last rebuild; otherwise each
+        // proxy is re-read in place and the ones whose bounds, layers or flags changed are appended
+        // to changed. Returns whether it rebuilt, in which case every proxy counts as changed.
+        bool sync(Scene &scene, std::vector<EntityId> &changed);
+        // Re-reads every collider, in view order.
+        void rebuild(Scene &scene);
+        // Re-reads one entity, adding, updating or dropping its proxy.
+        void update(const Entity &entity);
+        void remove(EntityId id);
+        void clear();
+
+        const ColliderProxy *find(EntityId id) const
+        {
+            const std::uint32_t slot = EntityIndex(id);
+            if (slot >= m_lookup.size() || m_lookup[slot] == 0u)
+            {
+                return nullptr;
+            }
+
+            const ColliderProxy &proxy = m_proxies[m_lookup[slot] - 1];
+            return proxy.id == id ? &proxy : nullptr;
+        }
+
+        // Null unless id collides by its mesh's triangles rather than its bounds.
+        const MeshShape *meshShape(EntityId id) const
+        {
+            const MeshShape *shape = findMesh(id);
+            return shape && shape->concave ? shape : nullptr;
+        }
+
+        // The cooked mesh resolved when id's proxy was read; null for other shapes.
+        const CollisionMesh *mesh(EntityId id) const
+        {
+            const MeshShape *shape = findMesh(id);
+            return shape ? shape->mesh : nullptr;
+        }
+
+        const std::vector<ColliderProxy> &proxies() const
+        {
+            return m_proxies;
+        }
+
+        std::size_t size() const
+        {
+            return m_proxies.size();
+        }
+
+    private:
+        const MeshShape *findMesh(EntityId id) const
+        {
+            const ColliderProxy *proxy = find(id);
+            if (!proxy || proxy->shape != ShapeKind::Mesh3D)
+            {
+                return nullptr;
+            }
+            return &m_meshShapes[static_cast<std::size_t>(proxy - m_proxies.data())];
+        }
+
+        // The in-place pass of sync(). False, with changed as it was, when a proxy can no longer
+        // be read and only a rebuild can drop it.
+        bool patch(Scene &scene, std::vector<EntityId> &changed);
+        void store(const ColliderProxy &proxy, const MeshShape &meshShape);
+
+        std::vector<ColliderProxy> m_proxies;
+        // Parallel to m_proxies, so the proxies stay small; mesh is null for other shapes.
+        std::vector<MeshShape> m_meshShapes;
+        // EntityIndex(id) -> proxy index + 1, 0 when absent.
+        std::vector<std::uint32_t> m_lookup;
+        // Scene revision of the proxy-shaping pools at the last rebuild().
+        std::uint64_t m_revision = 0;
+        bool m_built = false;
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+#include <Melkam/physics/SweepBatch.hpp>
+
+namespace Melkam
+{
+    class Entity;
+    struct CollisionMeshNode;
+
+    struct MeshHit
+    {
+        bool hit = false;
+        std::uint32_t triangle = 0;
+        // Fraction of the motion, in [0, 1].
+        float time = 1.0f;
+        // Unit length, facing the mover.
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        // At time 0 with the box already overlapping: how far along normal to push it out.
+        float depth = 0.0f;
+    };
+
+    // Cooks a triangle list (xyz positions, three indices per triangle) into the binary format
+    // CollisionMesh reads: a small header, then the BVH nodes, the triangles in leaf order and the
+    // vertices. Everything is a 4-byte value in the host's byte order with no pointers, so a file
+    // can be mapped and used in place; the header's magic number rejects the other byte order.
+    // Degenerate triangles are dropped. False when an index is out of range or nothing is left.
+    bool CookCollisionMesh(const float *positions, std::size_t vertexCount, const std::uint32_t *indices, std::size_t indexCount,
+                           std::vector<std::uint8_t> &outData);
+    bool WriteCookedCollisionMesh(const std::string &path, const std::vector<std::uint8_t> &data);
+
+    // A cooked triangle mesh in its local space. Like StaticBvh, the tree is flattened
+    // depth-first with skip links, so a query is one forward walk over 32-byte nodes. Nodes and
+    // triangles are only read, so queries are const and safe to run concurrently.
+    class CollisionMesh
+    {
+    public:
+        CollisionMesh() = default;
+        ~CollisionMesh();
+        CollisionMesh(const CollisionMesh &) = delete;
+        CollisionMesh &operator=(const CollisionMesh &) = delete;
+
+        // Maps a cooked file read-only instead of reading it. Both this and load() check the
+        // layout and every index once, so a damaged file is rejected rather than crashing a query.
+        bool map(const std::string &path);
+        // Takes over cooked data already in memory.
+        bool load(std::vector<std::uint8_t> data);
+        void reset();
+
+        bool isLoaded() const
+        {
+            return m_nodes != nullptr;
+        }
+
+        const Aabb3D &bounds() const
+        {
+            return m_bounds;
+        }
+
+        std::uint32_t triangleCount() const
+        {
+            return m_triangleCount;
+        }
+
+        // Earliest triangle the segment from origin to origin + motion crosses; either side
+        // counts.
+        bool raycast(const float origin[3], const float motion[3], MeshHit &outHit) const;
+        // Earliest triangle box touches while moving by motion, by separating axes, with the
+        // same contact rules as SweepAabbBatch: touching counts as a hit when moving into it, and
+        // an overlapping start hits at time 0 with the shallowest push-out. A box without extent
+        // is cast as a ray.
+        bool sweepAabb(const Aabb3D &box, const float motion[3], MeshHit &outHit) const;
+
+    private:
+        bool attach(const std::uint8_t *data, std::size_t size);
+
+        std::vector<std::uint8_t> m_owned;
+        void *m_mapped = nullptr;
+        std::size_t m_mappedSize = 0;
+
+        const CollisionMeshNode *m_nodes = nullptr;
+        const std::uint32_t *m_triangles = nullptr;
+        const float *m_vertices = nullptr;
+        std::uint32_t m_nodeCount = 0;
+        std::uint32_t m_triangleCount = 0;
+        Aabb3D m_bounds = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    };
+
+    // Cooked meshes by asset path, mapped on first use and kept for the library's lifetime, so
+    // proxies can hold on to them. Safe to call from any thread.
+    class CollisionMeshLibrary
+    {
+    public:
+        // Null, and logged once, when the file is missing or not a cooked mesh.
+        const CollisionMesh *load(const std::string &asset);
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::unique_ptr<CollisionMesh>> m_meshes;
+    };
+
+    // The cooked mesh behind the entity's CollisionMeshComponent, from its scene's PhysicsWorld.
+    const CollisionMesh *LoadCollisionMesh(const Entity &entity);
+
+    // A triangle-mesh collider gathered next to SweepCandidates3D; origin places the mesh.
+    struct MeshCandidate
+    {
+        EntityId id;
+        const CollisionMesh *mesh;
+        float origin[3];
+    };
+
+    // Sweeps mover against every mesh candidate and takes over best and bestId when a mesh is
+    // hit earlier, or at the same time with a lower id. Returns whether a mesh won; outDepth is
+    // then its push-out distance when the mover starts inside it.
+    bool SweepMeshCandidates(const Aabb3D &mover, const float motion[3], const std::vector<MeshCandidate> &meshes,
+                             SweepHit &best, EntityId &bestId, float &outDepth);
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    // Dynamic bounding-volume hierarchy for 3D colliders. Leaves keep a box fattened by margin,
+    // so small moves do not touch the tree; a leaf that leaves its fat box is reinserted at the
+    // sibling with the lowest surface-area cost, and AVL rotations keep the height logarithmic.
+    // Internal nodes carry the OR of their leaves' layers so queries skip subtrees their mask
+    // rejects. Queries are const and use a local stack, so concurrent queries are safe.
+    class DynamicAabbTree
+    {
+    public:
+        static constexpr std::int32_t Null = -1;
+
+        explicit DynamicAabbTree(float margin = 0.1f);
+
+        // Inserts id or moves its leaf.
+        void update(EntityId id, const Aabb3D &box, std::uint32_t layer, std::uint32_t mask);
+        void remove(EntityId id);
+        bool contains(EntityId id) const;
+        void clear();
+
+        std::size_t size() const
+        {
+            return m_leafCount;
+        }
+
+        // 0 for an empty tree or a single leaf.
+        std::int32_t height() const
+        {
+            return m_root == Null ? 0 : m_nodes[m_root].height;
+        }
+
+        // Bulk refresh: leaves not passed to update() between beginSync() and endSync() are removed.
+        void beginSync();
+        void endSync();
+
+        // Calls func(EntityId, const Aabb3D &) with the leaf's exact box for every leaf whose fat
+        // box touches box and whose layer/mask pair collides with (layer, mask).
+        template <typename Func>
+        void query(const Aabb3D &box, std::uint32_t layer, std::uint32_t mask, Func &&func) const
+        {
+            if (m_root == Null)
+            {
+                return;
+            }
+
+            NodeStack stack;
+            stack.push(m_root);
+            while (!stack.empty())
+            {
+                const Node &node = m_nodes[stack.pop()];
+                if ((node.layers & mask) == 0u || !overlaps(node.box, box))
+                {
+                    continue;
+                }
+
+                if (node.isLeaf())
+                {
+                    if ((node.mask & layer) != 0u)
+                    {
+                        func(node.id, node.tight);
+                    }
+                    continue;
+                }
+
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+
+        // Calls func(EntityId, const Aabb3D &) like query() for every leaf box touches while
+        // moving by motion, skipping subtrees the move misses.
+        template <typename Func>
+        void sweepQuery(const Aabb3D &box, const float motion[3], std::uint32_t layer, std::uint32_t mask, Func &&func) const
+        {
+            if (m_root == Null)
+            {
+                return;
+            }
+
+            NodeStack stack;
+            stack.push(m_root);
+            while (!stack.empty())
+            {
+                const Node &node = m_nodes[stack.pop()];
+                if ((node.layers & mask) == 0u || !SweepTouches(box, motion, node.box))
+                {
+                    continue;
+                }
+
+                if (node.isLeaf())
+                {
+                    if ((node.mask & layer) != 0u)
+                    {
+                        func(node.id, node.tight);
+                    }
+                    continue;
+                }
+
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+
+    private:
+        struct Node
+        {
+            Aabb3D box{};
+            // Leaves only: the box last passed to update(); box is its fattened copy.
+            Aabb3D tight{};
+            // Parent for live nodes, next free node for pooled ones.
+            std::int32_t parent = Null;
+            std::int32_t child1 = Null;
+            std::int32_t child2 = Null;
+            // 0 for leaves, -1 for pooled nodes.
+            std::int32_t height = -1;
+            EntityId id = InvalidEntity;
+            std::uint32_t layer = 0u;
+            std::uint32_t mask = 0u;
+            // OR of the layers below this node.
+            std::uint32_t layers = 0u;
+            std::uint32_t sync = 0;
+
+            bool isLeaf() const
+            {
+                return child1 == Null;
+            }
+        };
+
+        // Fixed local storage, spilling to the heap only for very deep trees.
+        class NodeStack
+        {
+        public:
+            void push(std::int32_t index)
+            {
+                if (m_count < Capacity)
+                {
+                    m_local[m_count++] = index;
+                }
+                else
+                {
+                    m_spill.push_back(index);
+                }
+            }
+
+            std::int32_t pop()
+            {
+                if (!m_spill.empty())
+                {
+                    const std::int32_t index = m_spill.back();
+                    m_spill.pop_back();
+                    return index;
+                }
+                return m_local[--m_count];
+            }
+
+            bool empty() const
+            {
+                return m_count == 0 && m_spill.empty();
+            }
+
+        private:
+            static constexpr std::size_t Capacity = 128;
+            std::int32_t m_local[Capacity];
+            std::size_t m_count = 0;
+            std::vector<std::int32_t> m_spill;
+        };
+
+        static bool overlaps(const Aabb3D &a, const Aabb3D &b)
+        {
+            return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY && a.minZ <= b.maxZ && a.maxZ >= b.minZ;
+        }
+
+        std::int32_t allocateNode();
+        void freeNode(std::int32_t index);
+        void insertLeaf(std::int32_t leaf);
+        void removeLeaf(std::int32_t leaf);
+        void destroyLeaf(std::int32_t leaf);
+        std::int32_t balance(std::int32_t index);
+        void refit(std::int32_t index);
+        std::int32_t findLeaf(EntityId id) const;
+
+        float m_margin = 0.1f;
+        std::vector<Node> m_nodes;
+        std::int32_t m_root = Null;
+        std::int32_t m_freeList = Null;
+        // EntityIndex(id) -> leaf node, Null when absent.
+        std::vector<std::int32_t> m_lookup;
+        std::size_t m_leafCount = 0;
+        std::uint32_t m_sync = 0;
+    };
+}
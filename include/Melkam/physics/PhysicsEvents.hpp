@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Melkam/scene/Components.hpp>
+
+namespace Melkam
+{
+    class Scene;
+    class Entity;
+
+    struct CollisionInfo
+    {
+        bool hit = false;
+        EntityId collider = InvalidEntity;
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        float travel = 0.0f;
+    };
+
+    using CollisionCallback = std::function<void(Entity self, Entity other, const CollisionInfo &info)>;
+    using AreaCallback = std::function<void(Entity area, Entity body)>;
+
+    // One side of a hit; each hit is recorded twice, from the mover and from what it hit.
+    struct CollisionEvent
+    {
+        EntityId self;
+        EntityId other;
+        // Points from other towards self.
+        float normal[3];
+        float travel;
+    };
+
+    struct AreaEvent
+    {
+        EntityId area;
+        EntityId body;
+    };
+
+    using CollisionListener = std::function<void(Scene &scene, const std::vector<CollisionEvent> &events)>;
+    using AreaListener = std::function<void(Scene &scene, const std::vector<AreaEvent> &events)>;
+
+    // Per-scene event queues, held by PhysicsWorld. Movers and the area system only append to
+    // flat per-type arrays while they run, and dispatch() hands each array to the scene's
+    // listeners and per-entity callbacks in one pass afterwards. Recording needs the same
+    // exclusive access as the moves that produce the events.
+    class PhysicsEvents
+    {
+    public:
+        void recordCollision(EntityId self, EntityId other, const float normal[3], float travel)
+        {
+            if (m_wantsCollisions)
+            {
+                m_collisions.push_back({self, other, {normal[0], normal[1], normal[2]}, travel});
+            }
+        }
+
+        void recordAreaEntered(EntityId area, EntityId body)
+        {
+            if (m_wantsAreaEntered)
+            {
+                m_areaEntered.push_back({area, body});
+            }
+        }
+
+        void recordAreaExited(EntityId area, EntityId body)
+        {
+            if (m_wantsAreaExited)
+            {
+                m_areaExited.push_back({area, body});
+            }
+        }
+
+        // Collisions, then area enters, then exits, each in the order recorded; listeners get
+        // the whole batch before the per-entity callbacks run. Events whose entities are gone
+        // by then are dropped. Events recorded by callbacks are delivered before this returns;
+        // a dispatch() from inside a callback leaves them to the outer one.
+        void dispatch(Scene &scene);
+
+        void connectCollision(EntityId entity, CollisionCallback callback);
+        void connectAreaEntered(EntityId area, AreaCallback callback);
+        void connectAreaExited(EntityId area, AreaCallback callback);
+
+        void listenCollisions(CollisionListener listener);
+        void listenAreaEntered(AreaListener listener);
+        void listenAreaExited(AreaListener listener);
+
+    private:
+        // Indexed by EntityIndex; a slot whose owner is not the event's entity has no callbacks.
+        template <typename Callback>
+        struct CallbackSlot
+        {
+            EntityId owner = InvalidEntity;
+            std::vector<Callback> callbacks;
+        };
+
+        std::vector<CollisionEvent> m_collisions;
+        std::vector<AreaEvent> m_areaEntered;
+        std::vector<AreaEvent> m_areaExited;
+        // What dispatch() is delivering, swapped out so callbacks can record new events.
+        std::vector<CollisionEvent> m_collisionBatch;
+        std::vector<AreaEvent> m_areaBatch;
+
+        std::vector<CallbackSlot<CollisionCallback>> m_collisionCallbacks;
+        std::vector<CallbackSlot<AreaCallback>> m_areaEnteredCallbacks;
+        std::vector<CallbackSlot<AreaCallback>> m_areaExitedCallbacks;
+        std::vector<CollisionListener> m_collisionListeners;
+        std::vector<AreaListener> m_areaEnteredListeners;
+        std::vector<AreaListener> m_areaExitedListeners;
+
+        // Nothing is recorded until something could receive it.
+        bool m_wantsCollisions = false;
+        bool m_wantsAreaEntered = false;
+        bool m_wantsAreaExited = false;
+        bool m_dispatching = false;
+    };
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <Melkam/physics/ColliderProxies.hpp>
+#include <Melkam/physics/CollisionMesh.hpp>
+#include <Melkam/physics/DynamicAabbTree.hpp>
+#include <Melkam/physics/PhysicsEvents.hpp>
+#include <Melkam/physics/RigidBodySolver.hpp>
+#include <Melkam/physics/SpatialHash2D.hpp>
+#include <Melkam/physics/StaticBvh.hpp>
+
+namespace Melkam
+{
+    class Scene;
+    class Entity;
+    class SystemAccess;
+
+    // Access token, never stored on entities: systems that sync, step or queue events on the
+    // scene's PhysicsWorld declare it written, so no two of them run at once.
+    struct PhysicsWorldAccess
+    {
+    };
+
+    // Declares PhysicsWorldAccess written plus every component a sync reads, for systems that call
+    // syncIfStale(), the move functions or the solvers. Add what the system itself writes on top.
+    void DeclarePhysicsWorldAccess(SystemAccess &access);
+
+    // Per-scene physics state, reached through PhysicsWorld::get(scene). Holds the broadphase
+    // structures the move and query functions use instead of scanning every collider, fed from
+    // a flat proxy per collider so no pair loop looks components up.
+    // Colliders with a StaticBody, StaticBody2D or StaticBody3D component are baked into
+    // immutable BVHs; everything else lives in the incremental hash and tree.
+    // Queries may run from concurrent read-only systems. syncIfStale(), refresh(), stepping and
+    // event recording change the world, so systems calling them declare PhysicsWorldAccess written.
+    class PhysicsWorld
+    {
+    public:
+        static PhysicsWorld &get(Scene &scene);
+
+        // Brings every collider's proxy up to date and moves the dynamic ones that changed in the
+        // hash and tree; the 2D snapshot is rebuilt only if one of those was 2D. The static BVHs
+        // are rebuilt only when a static body is added, removed, moved, resized or changes layers.
+        void sync(Scene &scene);
+
+        // sync() at most once per Scene::update frame. Transforms changed outside the physics
+        // functions after that are seen next frame, or after refresh().
+        void syncIfStale(Scene &scene);
+
+        // Updates one collider's proxy, e.g. after it was moved or teleported. For a static body
+        // this rebuilds the static BVHs at once instead of at the next sync().
+        void refresh(const Entity &entity);
+
+        // Fixed-step clock for systems that step physics at a fixed rate (1/120 s, at most 5
+        // steps per frame by default).
+        void setFixedTimestep(float seconds);
+        float fixedTimestep() const
+        {
+            return m_fixedTimestep;
+        }
+
+        void setMaxSubSteps(int steps);
+        int maxSubSteps() const
+        {
+            return m_maxSubSteps;
+        }
+
+        // Adds a frame's time and returns how many fixed steps to run now. Time beyond
+        // maxSubSteps() steps is dropped, so one slow frame cannot snowball into slower ones.
+        // Only the first call in a Scene::update frame adds time; later ones return the same
+        // count, so every fixed-step system in the frame runs the same number of steps.
+        int accumulate(const Scene &scene, float dt);
+
+        // Fraction of a step left over after accumulate(): how far rendering should blend from
+        // PreviousTransformComponent towards the current transform.
+        float interpolationAlpha() const;
+
+        // Whether id was a trigger or area collider when last synced or refreshed; movers pass
+        // through those.
+        bool isTrigger(EntityId id) const
+        {
+            const ColliderProxy *proxy = m_proxies.find(id);
+            return proxy && proxy->isTriggerLike();
+        }
+
+        // Every collider as of the last sync(), plus refresh() calls since.
+        const ColliderProxies &proxies() const
+        {
+            return m_proxies;
+        }
+
+        // Calls func(EntityId, const Aabb2D &) for dynamic and static 2D colliders touching box.
+        template <typename Func>
+        void query2D(const Aabb2D &box, std::uint32_t layer, std::uint32_t mask, Func &&func)
+        {
+            m_broadphase2D.query(box, layer, mask, func);
+            m_statics2D.query(box, layer, mask, [&](std::uint32_t index)
+            {
+                const auto &item = m_statics2D.item(index);
+                func(item.id, item.box);
+            });
+        }
+
+        template <typename Func>
+        void query3D(const Aabb3D &box, std::uint32_t layer, std::uint32_t mask, Func &&func)
+        {
+            m_broadphase3D.query(box, layer, mask, func);
+            m_statics3D.query(box, layer, mask, [&](std::uint32_t index)
+            {
+                const auto &item = m_statics3D.item(index);
+                func(item.id, item.box);
+            });
+        }
+
+        SpatialHash2D &broadphase2D()
+        {
+            return m_broadphase2D;
+        }
+
+        DynamicAabbTree &broadphase3D()
+        {
+            return m_broadphase3D;
+        }
+
+        // The dynamic 2D proxies copied into a BVH. Unlike the hash, its queries are const and
+        // safe from many threads at once. Rebuilt on the first call after a 2D proxy was added,
+        // moved or removed, so it is valid until the next sync() or refresh() that changes one;
+        // concurrent calls share one rebuild.
+        const StaticBvh2D &snapshot2D();
+
+        const StaticBvh2D &statics2D() const
+        {
+            return m_statics2D;
+        }
+
+        const StaticBvh3D &statics3D() const
+        {
+            return m_statics3D;
+        }
+
+        // Solvers for RigidBodyComponent, RigidBody2DComponent and RigidBody3DComponent bodies.
+        RigidBodySolver2D &rigidBodies2D()
+        {
+            return m_rigidBodies2D;
+        }
+
+        RigidBodySolver3D &rigidBodies3D()
+        {
+            return m_rigidBodies3D;
+        }
+
+        // Cooked CollisionMeshComponent meshes, by asset path.
+        CollisionMeshLibrary &meshes()
+        {
+            return m_meshes;
+        }
+
+        // Collision and area events waiting for dispatch, and who receives them.
+        PhysicsEvents &events()
+        {
+            return m_events;
+        }
+
+    private:
+        // Puts id's dynamic proxy in the hash or tree, or takes it out of both.
+        void place(EntityId id);
+        bool staticsChanged(Scene &scene, bool rebuilt) const;
+        void rebuildStatics(Scene &scene);
+
+        // Before the proxies, which point into it.
+        CollisionMeshLibrary m_meshes;
+        ColliderProxies m_proxies;
+        // Entities whose proxy the last sync() patched.
+        std::vector<EntityId> m_changed;
+        SpatialHash2D m_broadphase2D;
+        DynamicAabbTree m_broadphase3D;
+        StaticBvh2D m_statics2D;
+        StaticBvh3D m_statics3D;
+        StaticBvh2D m_snapshot2D;
+        std::vector<StaticBvh2D::Item> m_snapshotItems;
+        std::mutex m_snapshotMutex;
+        bool m_snapshotStale = true;
+        RigidBodySolver2D m_rigidBodies2D;
+        RigidBodySolver3D m_rigidBodies3D;
+        PhysicsEvents m_events;
+        // What each static was baked from; after a proxy rebuild, any difference triggers a rebake.
+        std::vector<ColliderProxy> m_staticProxies;
+        std::uint64_t m_staticRevision = 0;
+        bool m_staticsBuilt = false;
+        std::mutex m_syncMutex;
+        std::uint64_t m_syncedFrame = 0;
+        bool m_synced = false;
+        float m_fixedTimestep = 1.0f / 120.0f;
+        int m_maxSubSteps = 5;
+        float m_accumulator = 0.0f;
+        std::uint64_t m_clockFrame = 0;
+        int m_clockSteps = 0;
+        bool m_clockStarted = false;
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    class Scene;
+
+    // Which colliders a query sees. The query sits on `layer` and hits colliders whose layer is in
+    // `mask` and whose own mask accepts `layer`, as for movers; the defaults hit everything.
+    struct QueryFilter
+    {
+        std::uint32_t layer = 0xFFFFFFFFu;
+        std::uint32_t mask = 0xFFFFFFFFu;
+        bool hitTriggers = false;
+        // Typically the caster itself.
+        EntityId exclude = InvalidEntity;
+    };
+
+    struct Ray2D
+    {
+        float origin[2] = {0.0f, 0.0f};
+        // Need not be normalised.
+        float direction[2] = {1.0f, 0.0f};
+        float maxDistance = 1.0f;
+    };
+
+    struct Ray3D
+    {
+        float origin[3] = {0.0f, 0.0f, 0.0f};
+        float direction[3] = {0.0f, 0.0f, 1.0f};
+        float maxDistance = 1.0f;
+    };
+
+    struct QueryHit
+    {
+        bool hit = false;
+        EntityId collider = InvalidEntity;
+        // Ray casts: where the ray enters the collider. Shape casts: the box centre at impact.
+        float point[3] = {0.0f, 0.0f, 0.0f};
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        // Along the ray or the motion, and as a fraction of maxDistance or the motion.
+        float distance = 0.0f;
+        float fraction = 0.0f;
+    };
+
+    // Casts test against the colliders' bounds, as the movers do, and against the triangles of
+    // concave collision meshes: the nearest hit wins, equal distances go to the lower entity id,
+    // and a cast starting inside a collider hits it at distance 0. Bounds come from the last sync
+    // or refresh of the scene's PhysicsWorld; call these from systems that declare read access to
+    // transforms, world transforms, nodes, colliders, shapes and layers. They only read the
+    // broadphase, so concurrent calls are safe.
+    bool RayCast2D(Scene &scene, const Ray2D &ray, QueryHit &outHit, const QueryFilter &filter = {});
+    bool RayCast3D(Scene &scene, const Ray3D &ray, QueryHit &outHit, const QueryFilter &filter = {});
+    bool ShapeCast2D(Scene &scene, const Aabb2D &box, const float motion[2], QueryHit &outHit, const QueryFilter &filter = {});
+    bool ShapeCast3D(Scene &scene, const Aabb3D &box, const float motion[3], QueryHit &outHit, const QueryFilter &filter = {});
+
+    // One hit per ray in outHits. Rays are spread over the scene's thread pool, and each tests its
+    // candidates with the batch SIMD sweep; the result does not depend on the thread count.
+    void RayCastBatch2D(Scene &scene, const std::vector<Ray2D> &rays, std::vector<QueryHit> &outHits, const QueryFilter &filter = {});
+    void RayCastBatch3D(Scene &scene, const std::vector<Ray3D> &rays, std::vector<QueryHit> &outHits, const QueryFilter &filter = {});
+
+    // Colliders whose bounds overlap the shape (touching does not count), sorted by id into
+    // outIds. Returns the count. Collision meshes count by their bounds here too.
+    std::size_t OverlapBox2D(Scene &scene, const Aabb2D &box, std::vector<EntityId> &outIds, const QueryFilter &filter = {});
+    std::size_t OverlapBox3D(Scene &scene, const Aabb3D &box, std::vector<EntityId> &outIds, const QueryFilter &filter = {});
+    std::size_t OverlapCircle2D(Scene &scene, const float center[2], float radius, std::vector<EntityId> &outIds, const QueryFilter &filter = {});
+    std::size_t OverlapSphere3D(Scene &scene, const float center[3], float radius, std::vector<EntityId> &outIds, const QueryFilter &filter = {});
+}
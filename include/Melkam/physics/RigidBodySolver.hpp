@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    class Scene;
+    class PhysicsWorld;
+
+    // Sequential-impulse solver for rigid bodies with box-shaped bounds. Shapes are axis-aligned
+    // and never rotate, so bodies only carry linear velocity and each contact pushes along one
+    // axis. Contacts are speculative: a body sees what it could reach this step, so resting
+    // stacks do not sink and bounce back. Accumulated impulses are cached per body pair and
+    // warm-start the next step, which lets tall piles settle in a few iterations.
+    //
+    // Bodies joined by contacts form islands. An island whose bodies all stay slower than
+    // sleepSpeed for timeToSleep seconds goes to sleep: its bodies are skipped by every stage of
+    // the step until a moving body or a new contact touches them, their velocity is set, or a
+    // collider they rest on is removed.
+    template <typename Box>
+    class RigidBodySolver
+    {
+    public:
+        struct Settings
+        {
+            float gravity[3];
+            // Penetration left unresolved so resting contacts persist from step to step.
+            float slop;
+            // Speed below which a body counts as resting.
+            float sleepSpeed;
+            float timeToSleep = 0.5f;
+            float friction = 0.4f;
+            float restitution = 0.0f;
+            // Fraction of the penetration beyond slop pushed out per step.
+            float baumgarte = 0.2f;
+            int iterations = 8;
+        };
+
+        // Defaults suit the scale of each dimension: pixels with y down in 2D, metres with y up in 3D.
+        RigidBodySolver();
+
+        Settings &settings()
+        {
+            return m_settings;
+        }
+
+        const Settings &settings() const
+        {
+            return m_settings;
+        }
+
+        // Advances every awake body of this dimension by dt: gravity, contacts, integration,
+        // islands and sleep, then refreshes the moved bodies' broadphase proxies.
+        void step(Scene &scene, PhysicsWorld &world, float dt);
+
+        void wake(EntityId id);
+        bool isSleeping(EntityId id) const;
+
+        // Bodies simulated by the last step, i.e. not asleep.
+        std::size_t awakeCount() const
+        {
+            return m_bodies.size();
+        }
+
+        void clear();
+
+    private:
+        static constexpr std::uint32_t NoBody = 0xFFFFFFFFu;
+
+        // Persistent per entity, indexed by EntityIndex.
+        struct BodyState
+        {
+            EntityId id = InvalidEntity;
+            float sleepTime = 0.0f;
+            // Sleeping island, 0 while awake.
+            std::uint32_t island = 0;
+            // Index into m_bodies during a step, NoBody otherwise.
+            std::uint32_t body = NoBody;
+        };
+
+        struct Body
+        {
+            EntityId id;
+            TransformComponent *transform;
+            PreviousTransformComponent *previous;
+            float *velocity;
+            float v[3];
+            float invMass;
+            Box box;
+            std::uint32_t layer;
+            std::uint32_t mask;
+            std::uint32_t parent;
+        };
+
+        struct Contact
+        {
+            EntityId idA;
+            EntityId idB;
+            std::uint32_t a;
+            // NoBody for colliders the solver does not move.
+            std::uint32_t b;
+            int axis;
+            // Normal is sign along axis, pointing from A to B.
+            float sign;
+            float separation;
+            float normalMass;
+            float bias;
+            float normalImpulse;
+            float tangentImpulse[2];
+
+            bool operator<(const Contact &other) const
+            {
+                return idA < other.idA || (idA == other.idA && idB < other.idB);
+            }
+        };
+
+        struct SleepingIsland
+        {
+            std::vector<EntityId> bodies;
+            // Colliders outside the island it rests on.
+            std::vector<EntityId> supports;
+        };
+
+        BodyState &state(EntityId id);
+        const BodyState *findState(EntityId id) const;
+        void gather(Scene &scene);
+        void addBody(Entity &entity, TransformComponent &transform, float *velocity, float mass, bool kinematic);
+        void wakeIsland(std::uint32_t island);
+        void wakeUnsupported(Scene &scene);
+        // Whether last step had a contact keyed (idA, idB).
+        bool touchedLastStep(EntityId idA, EntityId idB) const;
+        void findContacts(Scene &scene, PhysicsWorld &world, float dt);
+        void solve(float dt);
+        std::uint32_t findRoot(std::uint32_t body);
+        void updateSleep(float dt);
+
+        Settings m_settings;
+        std::vector<BodyState> m_states;
+        std::vector<Body> m_bodies;
+        std::vector<Contact> m_contacts;
+        // Last step's contacts, sorted by pair, for warm starting.
+        std::vector<Contact> m_cache;
+        std::unordered_map<std::uint32_t, SleepingIsland> m_islands;
+        std::vector<std::uint32_t> m_pendingWakes;
+        std::uint32_t m_nextIsland = 1;
+        std::uint64_t m_colliderRevision = 0;
+    };
+
+    extern template class RigidBodySolver<Aabb2D>;
+    extern template class RigidBodySolver<Aabb3D>;
+
+    using RigidBodySolver2D = RigidBodySolver<Aabb2D>;
+    using RigidBodySolver3D = RigidBodySolver<Aabb3D>;
+}
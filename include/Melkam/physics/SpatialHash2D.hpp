@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    // Uniform-grid broadphase for 2D colliders. Each proxy is listed in every cell its AABB
+    // covers; update() only touches cells when that cell range changes. Proxies spanning more
+    // than MaxCellsPerProxy cells go to an overflow list that every query checks.
+    // Queries stamp proxies to report each one once, so they are not reentrant or thread-safe.
+    class SpatialHash2D
+    {
+    public:
+        static constexpr std::size_t MaxCellsPerProxy = 64;
+
+        explicit SpatialHash2D(float cellSize = 4.0f);
+
+        // Re-buckets every proxy.
+        void setCellSize(float cellSize);
+        float cellSize() const
+        {
+            return m_cellSize;
+        }
+
+        // Inserts id or moves its proxy.
+        void update(EntityId id, const Aabb2D &box, std::uint32_t layer, std::uint32_t mask);
+        void remove(EntityId id);
+        bool contains(EntityId id) const;
+        void clear();
+
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        // Bulk refresh: proxies not passed to update() between beginSync() and endSync() are removed.
+        void beginSync();
+        void endSync();
+
+        // Calls func(EntityId, const Aabb2D &, std::uint32_t layer, std::uint32_t mask) for every proxy.
+        template <typename Func>
+        void each(Func &&func) const
+        {
+            for (const Proxy &proxy : m_proxies)
+            {
+                if (proxy.id != InvalidEntity)
+                {
+                    func(proxy.id, proxy.box, proxy.layer, proxy.mask);
+                }
+            }
+        }
+
+        // Calls func(EntityId, const Aabb2D &) once per proxy touching box whose layer/mask pair
+        // collides with (layer, mask).
+        template <typename Func>
+        void query(const Aabb2D &box, std::uint32_t layer, std::uint32_t mask, Func &&func)
+        {
+            const std::uint32_t stamp = nextVisit();
+            auto visit = [&](std::uint32_t index)
+            {
+                Proxy &proxy = m_proxies[index];
+                if (proxy.visit == stamp)
+                {
+                    return;
+                }
+                proxy.visit = stamp;
+
+                if (LayersCollide(layer, mask, proxy.layer, proxy.mask) && Overlaps(box, proxy.box))
+                {
+                    func(proxy.id, proxy.box);
+                }
+            };
+
+            const CellRange range = cellRange(box);
+            if (range.count() > m_count)
+            {
+                // Querying more cells than there are proxies; a flat scan is cheaper.
+                for (std::uint32_t i = 0; i < m_proxies.size(); ++i)
+                {
+                    if (m_proxies[i].id != InvalidEntity)
+                    {
+                        visit(i);
+                    }
+                }
+                return;
+            }
+
+            for (std::int32_t y = range.minY; y <= range.maxY; ++y)
+            {
+                for (std::int32_t x = range.minX; x <= range.maxX; ++x)
+                {
+                    const auto it = m_cells.find(cellKey(x, y));
+                    if (it == m_cells.end())
+                    {
+                        continue;
+                    }
+
+                    for (std::uint32_t index : it->second)
+                    {
+                        visit(index);
+                    }
+                }
+            }
+
+            for (std::uint32_t index : m_oversized)
+            {
+                visit(index);
+            }
+        }
+
+    private:
+        struct CellRange
+        {
+            std::int32_t minX = 0;
+            std::int32_t minY = 0;
+            std::int32_t maxX = -1;
+            std::int32_t maxY = -1;
+
+            std::size_t count() const
+            {
+                return static_cast<std::size_t>(maxX - minX + 1) * static_cast<std::size_t>(maxY - minY + 1);
+            }
+
+            bool operator==(const CellRange &other) const
+            {
+                return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+            }
+        };
+
+        struct Proxy
+        {
+            EntityId id = InvalidEntity;
+            Aabb2D box{};
+            std::uint32_t layer = 1u;
+            std::uint32_t mask = 0xFFFFFFFFu;
+            CellRange cells;
+            bool oversized = false;
+            std::uint32_t sync = 0;
+            std::uint32_t visit = 0;
+        };
+
+        static std::uint64_t cellKey(std::int32_t x, std::int32_t y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        CellRange cellRange(const Aabb2D &box) const;
+        std::int32_t cellCoord(float value) const;
+        void link(std::uint32_t index);
+        void unlink(std::uint32_t index);
+        std::uint32_t nextVisit();
+
+        float m_cellSize = 4.0f;
+        float m_inverseCellSize = 0.25f;
+        std::vector<Proxy> m_proxies;
+        std::vector<std::uint32_t> m_freeProxies;
+        // EntityIndex(id) -> proxy index + 1; 0 means no proxy.
+        std::vector<std::uint32_t> m_lookup;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_cells;
+        std::vector<std::uint32_t> m_oversized;
+        std::size_t m_count = 0;
+        std::uint32_t m_sync = 0;
+        std::uint32_t m_visit = 0;
+    };
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    // Immutable bounding-volume hierarchy for colliders that do not move. build() packs the
+    // items into leaf order and flattens the tree depth-first with skip links, so a query is one
+    // forward walk over two arrays with no stack. There is no incremental update: rebuild when
+    // the set changes. Queries are const and safe to run concurrently.
+    template <typename Box>
+    class StaticBvh
+    {
+    public:
+        static constexpr std::uint32_t LeafSize = 4;
+
+        struct Item
+        {
+            Box box;
+            EntityId id;
+            std::uint32_t layer;
+            std::uint32_t mask;
+        };
+
+        void build(const std::vector<Item> &items);
+        void clear();
+
+        std::size_t size() const
+        {
+            return m_items.size();
+        }
+
+        bool empty() const
+        {
+            return m_items.empty();
+        }
+
+        // Item by its position in build()'s input.
+        const Item &item(std::uint32_t index) const
+        {
+            return m_items[m_slots[index]];
+        }
+
+        // Calls func(std::uint32_t index) for every item touching box whose layer/mask pair
+        // collides with (layer, mask); index is the item's position in build()'s input.
+        template <typename Func>
+        void query(const Box &box, std::uint32_t layer, std::uint32_t mask, Func &&func) const
+        {
+            const std::uint32_t count = static_cast<std::uint32_t>(m_nodes.size());
+            std::uint32_t index = 0;
+            while (index < count)
+            {
+                const Node &node = m_nodes[index];
+                if ((node.layers & mask) == 0u || !Overlaps(node.box, box))
+                {
+                    index = node.skip;
+                    continue;
+                }
+
+                // Internal nodes have no items; the next node is their first child.
+                for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                {
+                    const Item &item = m_items[i];
+                    if (LayersCollide(layer, mask, item.layer, item.mask) && Overlaps(box, item.box))
+                    {
+                        func(m_order[i]);
+                    }
+                }
+                ++index;
+            }
+        }
+
+        // Calls func(std::uint32_t index) for every item box touches while moving by motion
+        // (z is ignored in 2D), under the same layer rules as query(). Subtrees the move misses
+        // are skipped, so long rays do not visit everything their bounding box covers.
+        template <typename Func>
+        void sweepQuery(const Box &box, const float motion[3], std::uint32_t layer, std::uint32_t mask, Func &&func) const
+        {
+            const std::uint32_t count = static_cast<std::uint32_t>(m_nodes.size());
+            std::uint32_t index = 0;
+            while (index < count)
+            {
+                const Node &node = m_nodes[index];
+                if ((node.layers & mask) == 0u || !SweepTouches(box, motion, node.box))
+                {
+                    index = node.skip;
+                    continue;
+                }
+
+                for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                {
+                    const Item &item = m_items[i];
+                    if (LayersCollide(layer, mask, item.layer, item.mask) && SweepTouches(box, motion, item.box))
+                    {
+                        func(m_order[i]);
+                    }
+                }
+                ++index;
+            }
+        }
+
+    private:
+        struct Node
+        {
+            Box box;
+            std::uint32_t first;
+            std::uint32_t count;
+            // Index of the first node after this subtree.
+            std::uint32_t skip;
+            // OR of the layers below this node.
+            std::uint32_t layers;
+        };
+
+        struct BuildEntry
+        {
+            std::uint32_t index;
+            float center[3];
+        };
+
+        void buildRange(const std::vector<Item> &items, std::vector<BuildEntry> &entries, std::size_t begin, std::size_t end);
+
+        std::vector<Node> m_nodes;
+        // Items in leaf order, with their input index alongside.
+        std::vector<Item> m_items;
+        std::vector<std::uint32_t> m_order;
+        // Input index -> position in m_items.
+        std::vector<std::uint32_t> m_slots;
+    };
+
+    extern template class StaticBvh<Aabb2D>;
+    extern template class StaticBvh<Aabb3D>;
+
+    using StaticBvh2D = StaticBvh<Aabb2D>;
+    using StaticBvh3D = StaticBvh<Aabb3D>;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    // Sort-and-sweep overlap finder for trigger areas. Box endpoints on the x axis persist
+    // between sweeps and are re-sorted with insertion sort, which is close to linear when
+    // proxies move a little each frame. Only sensor/body pairs are reported, which is all area
+    // signals need, so bodies never pay for overlapping each other.
+    template <typename Box>
+    class SweepAndPrune
+    {
+    public:
+        struct Pair
+        {
+            EntityId sensor;
+            EntityId body;
+
+            bool operator<(const Pair &other) const
+            {
+                return sensor < other.sensor || (sensor == other.sensor && body < other.body);
+            }
+
+            bool operator==(const Pair &other) const
+            {
+                return sensor == other.sensor && body == other.body;
+            }
+        };
+
+        // Inserts id or updates its box, layers and role. An inverted box is flipped back into
+        // order; one with a NaN bound removes id until it is valid again.
+        void update(EntityId id, const Box &box, std::uint32_t layer, std::uint32_t mask, bool sensor);
+        void remove(EntityId id);
+        bool contains(EntityId id) const;
+        bool isSensor(EntityId id) const;
+        void clear();
+
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        // Bulk refresh: proxies not passed to update() between beginSync() and endSync() are removed.
+        void beginSync();
+        void endSync();
+
+        // Re-sorts the endpoints and returns every intersecting sensor/body pair whose layers
+        // collide, ordered by (sensor, body). Valid until the next sweep().
+        const std::vector<Pair> &sweep();
+
+    private:
+        static constexpr std::uint32_t NotActive = 0xFFFFFFFFu;
+
+        struct Proxy
+        {
+            Box box{};
+            EntityId id = InvalidEntity;
+            std::uint32_t layer = 0u;
+            std::uint32_t mask = 0u;
+            std::uint32_t sync = 0;
+            // Position in m_activeSensors/m_activeBodies while the sweep is inside the box.
+            std::uint32_t active = NotActive;
+            bool sensor = false;
+            bool live = false;
+        };
+
+        struct Endpoint
+        {
+            float value;
+            // proxy << 1 | 1 for a max endpoint.
+            std::uint32_t data;
+
+            std::uint32_t proxy() const
+            {
+                return data >> 1;
+            }
+
+            bool isMax() const
+            {
+                return (data & 1u) != 0u;
+            }
+        };
+
+        std::uint32_t findProxy(EntityId id) const;
+        void compactEndpoints();
+
+        std::vector<Proxy> m_proxies;
+        // Proxy slots released by the last compaction; dead proxies keep their endpoints until then.
+        std::vector<std::uint32_t> m_freeProxies;
+        // EntityIndex(id) -> proxy index + 1, 0 when absent.
+        std::vector<std::uint32_t> m_lookup;
+        std::vector<Endpoint> m_endpoints;
+        std::vector<std::uint32_t> m_activeSensors;
+        std::vector<std::uint32_t> m_activeBodies;
+        std::vector<Pair> m_pairs;
+        std::size_t m_count = 0;
+        std::uint32_t m_sync = 0;
+        bool m_hasDead = false;
+    };
+
+    extern template class SweepAndPrune<Aabb2D>;
+    extern template class SweepAndPrune<Aabb3D>;
+}
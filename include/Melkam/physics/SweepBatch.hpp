@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Melkam/core/AlignedArray.hpp>
+#include <Melkam/physics/Bounds.hpp>
+
+namespace Melkam
+{
+    // Candidate boxes in SoA layout, filled from a broadphase query and swept in one call.
+    struct SweepCandidates2D
+    {
+        std::vector<EntityId> ids;
+        AlignedArray<float> minX;
+        AlignedArray<float> minY;
+        AlignedArray<float> maxX;
+        AlignedArray<float> maxY;
+
+        void clear();
+        void push(EntityId id, const Aabb2D &box);
+        Aabb2D box(std::size_t index) const;
+
+        std::size_t size() const
+        {
+            return ids.size();
+        }
+    };
+
+    struct SweepCandidates3D
+    {
+        std::vector<EntityId> ids;
+        AlignedArray<float> minX;
+        AlignedArray<float> minY;
+        AlignedArray<float> minZ;
+        AlignedArray<float> maxX;
+        AlignedArray<float> maxY;
+        AlignedArray<float> maxZ;
+
+        void clear();
+        void push(EntityId id, const Aabb3D &box);
+        Aabb3D box(std::size_t index) const;
+
+        std::size_t size() const
+        {
+            return ids.size();
+        }
+    };
+
+    struct SweepHit
+    {
+        bool hit = false;
+        // Position in the candidate arrays.
+        std::size_t index = 0;
+        float time = 1.0f;
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+    };
+
+    // Earliest candidate the mover box hits while moving by the given motion, with time in
+    // [0, 1) and the face normal it hits (time 0 and the shallowest push-out normal when the
+    // boxes already overlap). Equal times go to the lower entity id. The backend is chosen by
+    // MELKAM_SIMD like the math kernels; every backend returns the same hit bit for bit.
+    SweepHit SweepAabbBatch(const Aabb2D &mover, float dx, float dy, const SweepCandidates2D &candidates);
+    SweepHit SweepAabbBatch(const Aabb3D &mover, float dx, float dy, float dz, const SweepCandidates3D &candidates);
+}
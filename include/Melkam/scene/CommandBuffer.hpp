@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Components.hpp"
+
+namespace Melkam
+{
+    class Scene;
+
+    // Records structural changes (create/destroy, add/remove component, reparent) so they can
+    // be requested while views and groups are being walked, then applies them in one batch.
+    // Recording is thread-safe; flush() must run on the thread that owns the scene.
+    class CommandBuffer
+    {
+    public:
+        explicit CommandBuffer(Scene &scene);
+
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+        // Returns a placeholder id that this buffer's other commands accept until flush().
+        EntityId createEntity(const std::string &name = "Entity", EntityId parent = InvalidEntity);
+        void destroyEntity(EntityId id);
+        void setParent(EntityId child, EntityId parent);
+
+        template <typename T, typename... Args>
+        void addComponent(EntityId id, Args &&...args);
+
+        template <typename T>
+        void removeComponent(EntityId id);
+
+        bool empty() const;
+
+        // Playback order: creates, component adds, reparenting, component removes, destroys.
+        // Commands aimed at entities that died in the meantime are dropped.
+        void flush();
+        void clear();
+
+        static bool isPlaceholder(EntityId id);
+
+    private:
+        struct IQueue
+        {
+            virtual ~IQueue() = default;
+            virtual bool empty() const = 0;
+            virtual void applyAdds(CommandBuffer &buffer) = 0;
+            virtual void applyRemoves(CommandBuffer &buffer) = 0;
+            virtual void clear() = 0;
+        };
+
+        template <typename T>
+        struct Queue;
+
+        struct ParentCommand
+        {
+            EntityId child = InvalidEntity;
+            EntityId parent = InvalidEntity;
+        };
+
+        template <typename T>
+        Queue<T> &queue();
+
+        EntityId resolve(EntityId id) const;
+
+        Scene &m_scene;
+        mutable std::mutex m_mutex;
+        std::vector<std::string> m_creates;
+        std::vector<EntityId> m_created;
+        std::vector<ParentCommand> m_parents;
+        std::vector<EntityId> m_destroys;
+        std::vector<std::unique_ptr<IQueue>> m_queues; // indexed by componentTypeId<T>()
+    };
+}
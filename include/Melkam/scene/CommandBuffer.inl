@@ -0,0 +1,89 @@
+#pragma once
+
+namespace Melkam
+{
+    template <typename T>
+    struct CommandBuffer::Queue final : CommandBuffer::IQueue
+    {
+        std::vector<std::pair<EntityId, T>> adds;
+        std::vector<EntityId> removes;
+
+        bool empty() const override
+        {
+            return adds.empty() && removes.empty();
+        }
+
+        void applyAdds(CommandBuffer &buffer) override
+        {
+            if (adds.empty())
+            {
+                return;
+            }
+
+            Scene &scene = buffer.m_scene;
+            scene.reserveComponents<T>(adds.size());
+            for (auto &[id, value] : adds)
+            {
+                const EntityId target = buffer.resolve(id);
+                if (scene.isValid(target))
+                {
+                    scene.addComponent<T>(target, std::move(value));
+                }
+            }
+            adds.clear();
+        }
+
+        void applyRemoves(CommandBuffer &buffer) override
+        {
+            if (removes.empty())
+            {
+                return;
+            }
+
+            for (auto &id : removes)
+            {
+                id = buffer.resolve(id);
+            }
+            buffer.m_scene.removeComponents<T>(removes);
+            removes.clear();
+        }
+
+        void clear() override
+        {
+            adds.clear();
+            removes.clear();
+        }
+    };
+
+    template <typename T>
+    CommandBuffer::Queue<T> &CommandBuffer::queue()
+    {
+        const ComponentTypeId type = componentTypeId<T>();
+        if (type >= m_queues.size())
+        {
+            m_queues.resize(type + 1);
+        }
+
+        auto &slot = m_queues[type];
+        if (!slot)
+        {
+            slot = std::make_unique<Queue<T>>();
+        }
+        return *static_cast<Queue<T> *>(slot.get());
+    }
+
+    template <typename T, typename... Args>
+    void CommandBuffer::addComponent(EntityId id, Args &&...args)
+    {
+        T value(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        queue<T>().adds.emplace_back(id, std::move(value));
+    }
+
+    template <typename T>
+    void CommandBuffer::removeComponent(EntityId id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        queue<T>().removes.push_back(id);
+    }
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Components.hpp"
+
+namespace Melkam
+{
+    // Sequential per-type ids, assigned on first use; they index Scene's flat storage table.
+    using ComponentTypeId = std::uint32_t;
+
+    inline ComponentTypeId nextComponentTypeId()
+    {
+        static std::atomic<ComponentTypeId> next{0};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    ComponentTypeId componentTypeId()
+    {
+        static const ComponentTypeId id = nextComponentTypeId();
+        return id;
+    }
+
+    struct IComponentGroup
+    {
+        virtual ~IComponentGroup() = default;
+        virtual void onComponentAdded(EntityId id) = 0;
+        virtual void onComponentRemoving(EntityId id) = 0;
+    };
+
+    struct IComponentStorage
+    {
+        virtual ~IComponentStorage() = default;
+        virtual void remove(EntityId id) = 0;
+        virtual void removeMany(const std::vector<EntityId> &ids) = 0;
+        virtual bool has(EntityId id) const = 0;
+        virtual std::size_t size() const = 0;
+
+        // Groups that own or observe this pool; owner is the one allowed to reorder it.
+        std::vector<IComponentGroup *> groups;
+        IComponentGroup *owner = nullptr;
+
+        // Bumped by every emplace and removal; caches over a component set compare it to skip rescans.
+        std::uint64_t revision = 0;
+    };
+
+    // Sparse set: m_sparse maps an entity slot index to its position in the packed
+    // m_entities/m_data arrays. The full id is compared so stale handles miss.
+    template <typename T>
+    class ComponentStorage : public IComponentStorage
+    {
+    public:
+        static constexpr std::uint32_t NullIndex = 0xFFFFFFFFu;
+
+        template <typename... Args>
+        T &emplace(EntityId id, Args &&...args)
+        {
+            ++revision;
+            const std::size_t sparse = sparseIndex(id);
+            if (sparse >= m_sparse.size())
+            {
+                m_sparse.resize(sparse + 1, NullIndex);
+            }
+
+            const std::uint32_t slot = m_sparse[sparse];
+            if (slot != NullIndex)
+            {
+                if (m_entities[slot] == id)
+                {
+                    m_data[slot] = T(std::forward<Args>(args)...);
+                    return m_data[slot];
+                }
+                remove(m_entities[slot]);
+            }
+
+            m_sparse[sparse] = static_cast<std::uint32_t>(m_entities.size());
+            m_entities.push_back(id);
+            m_data.push_back(T(std::forward<Args>(args)...));
+            if (groups.empty())
+            {
+                return m_data.back();
+            }
+
+            for (auto *group : groups)
+            {
+                group->onComponentAdded(id);
+            }
+            return m_data[find(id)];
+        }
+
+        void remove(EntityId id) override
+        {
+            if (find(id) == NullIndex)
+            {
+                return;
+            }
+
+            ++revision;
+            for (auto *group : groups)
+            {
+                group->onComponentRemoving(id);
+            }
+
+            const std::uint32_t slot = find(id);
+            const std::size_t sparse = sparseIndex(id);
+            const std::uint32_t last = static_cast<std::uint32_t>(m_entities.size() - 1);
+            if (slot != last)
+            {
+                const EntityId moved = m_entities[last];
+                m_entities[slot] = moved;
+                m_data[slot] = std::move(m_data[last]);
+                m_sparse[sparseIndex(moved)] = slot;
+            }
+
+            m_entities.pop_back();
+            m_data.pop_back();
+            m_sparse[sparse] = NullIndex;
+        }
+
+        // Removes a batch of ids with one stable compaction pass over the packed arrays.
+        void removeMany(const std::vector<EntityId> &ids) override
+        {
+            // Grouped pools must notify per entity, and a few removals are cheaper one at a time.
+            if (!groups.empty() || ids.size() * 4 < m_entities.size())
+            {
+                for (EntityId id : ids)
+                {
+                    remove(id);
+                }
+                return;
+            }
+
+            bool any = false;
+            for (EntityId id : ids)
+            {
+                if (find(id) != NullIndex)
+                {
+                    m_sparse[sparseIndex(id)] = NullIndex;
+                    any = true;
+                }
+            }
+
+            if (!any)
+            {
+                return;
+            }
+
+            ++revision;
+
+            std::uint32_t write = 0;
+            for (std::uint32_t read = 0; read < m_entities.size(); ++read)
+            {
+                const std::size_t sparse = sparseIndex(m_entities[read]);
+                if (m_sparse[sparse] == NullIndex)
+                {
+                    continue;
+                }
+
+                if (write != read)
+                {
+                    m_entities[write] = m_entities[read];
+                    m_data[write] = std::move(m_data[read]);
+                }
+                m_sparse[sparse] = write++;
+            }
+
+            m_entities.resize(write);
+            m_data.erase(m_data.begin() + write, m_data.end());
+        }
+
+        bool has(EntityId id) const override
+        {
+            return find(id) != NullIndex;
+        }
+
+        T *tryGet(EntityId id)
+        {
+            const std::uint32_t slot = find(id);
+            return slot == NullIndex ? nullptr : &m_data[slot];
+        }
+
+        const T *tryGet(EntityId id) const
+        {
+            const std::uint32_t slot = find(id);
+            return slot == NullIndex ? nullptr : &m_data[slot];
+        }
+
+        // Position of id in the packed arrays, or NullIndex.
+        std::uint32_t find(EntityId id) const
+        {
+            const std::size_t sparse = sparseIndex(id);
+            if (sparse >= m_sparse.size())
+            {
+                return NullIndex;
+            }
+
+            const std::uint32_t slot = m_sparse[sparse];
+            return (slot != NullIndex && m_entities[slot] == id) ? slot : NullIndex;
+        }
+
+        std::size_t size() const override
+        {
+            return m_entities.size();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            m_entities.reserve(capacity);
+            m_data.reserve(capacity);
+        }
+
+        void swapSlots(std::uint32_t a, std::uint32_t b)
+        {
+            if (a == b)
+            {
+                return;
+            }
+
+            std::swap(m_entities[a], m_entities[b]);
+            std::swap(m_data[a], m_data[b]);
+            m_sparse[sparseIndex(m_entities[a])] = a;
+            m_sparse[sparseIndex(m_entities[b])] = b;
+        }
+
+        const std::vector<EntityId> &entities() const
+        {
+            return m_entities;
+        }
+
+        T *data()
+        {
+            return m_data.data();
+        }
+
+        const T *data() const
+        {
+            return m_data.data();
+        }
+
+    private:
+        static std::size_t sparseIndex(EntityId id)
+        {
+            return EntityIndex(id);
+        }
+
+        std::vector<std::uint32_t> m_sparse;
+        std::vector<EntityId> m_entities;
+        std::vector<T> m_data;
+    };
+}
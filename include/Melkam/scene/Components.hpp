@@ -7,9 +7,25 @@
 
 namespace Melkam
 {
+    // Low 32 bits: slot index. High 32 bits: slot generation, never 0 for a live id.
     using EntityId = std::uint64_t;
     constexpr EntityId InvalidEntity = 0;
 
+    constexpr std::uint32_t EntityIndex(EntityId id)
+    {
+        return static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    }
+
+    constexpr std::uint32_t EntityVersion(EntityId id)
+    {
+        return static_cast<std::uint32_t>(id >> 32);
+    }
+
+    constexpr EntityId MakeEntityId(std::uint32_t index, std::uint32_t version)
+    {
+        return (static_cast<EntityId>(version) << 32) | static_cast<EntityId>(index);
+    }
+
     struct NameComponent
     {
         std::string name;
@@ -28,6 +44,32 @@ namespace Melkam
         Vector3f scale = {1.0f, 1.0f, 1.0f};
     };
 
+    // World-space transform derived from TransformComponent through the NodeComponent parent
+    // chain. Maintained by Scene::updateWorldTransforms(); treat it as read-only.
+    struct WorldTransformComponent
+    {
+        Matrix4f matrix;
+        Matrix4f local;
+
+        // Local TRS that `local` was built from and the parent `matrix` was composed under; a
+        // mismatch marks the entity dirty.
+        Vector3f position = {0.0f, 0.0f, 0.0f};
+        Vector3f rotation = {0.0f, 0.0f, 0.0f};
+        Vector3f scale = {1.0f, 1.0f, 1.0f};
+        EntityId parent = InvalidEntity;
+        bool built = false;
+    };
+
+    // Transform at the start of the last fixed physics step. Renderers blend it towards
+    // TransformComponent by PhysicsWorld::interpolationAlpha(), so motion stays smooth when the
+    // physics rate is below the frame rate. Filled by the fixed-step physics; add it to opt in.
+    struct PreviousTransformComponent
+    {
+        Vector3f position = {0.0f, 0.0f, 0.0f};
+        Vector3f rotation = {0.0f, 0.0f, 0.0f};
+        bool captured = false;
+    };
+
     struct CameraComponent
     {
         float fov = 60.0f;
@@ -130,11 +172,15 @@ namespace Melkam
     struct RigidBody2DComponent
     {
         float mass = 1.0f;
+        float velocity[2] = {0.0f, 0.0f};
+        bool isKinematic = false;
     };
 
     struct RigidBody3DComponent
     {
         float mass = 1.0f;
+        float velocity[3] = {0.0f, 0.0f, 0.0f};
+        bool isKinematic = false;
     };
 
     struct BoxShape2DComponent
@@ -175,6 +221,9 @@ namespace Melkam
         float height = 1.0f;
     };
 
+    // Collides as a mesh cooked by CookCollisionMesh(). meshAsset is the cooked file's path.
+    // Convex meshes collide as their bounds; concave ones by their triangles, which suits level
+    // geometry that other colliders move against.
     struct CollisionMeshComponent
     {
         std::string meshAsset;
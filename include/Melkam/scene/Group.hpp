@@ -0,0 +1,157 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+
+namespace Melkam
+{
+    class Scene;
+
+    // Component types a group requires but does not own (and therefore does not reorder).
+    template <typename... Types>
+    struct Observe
+    {
+    };
+
+    template <typename Observed, typename... Owned>
+    class Group;
+
+    // Owning group: the first size() slots of every owned pool hold the group's
+    // entities in the same order, so owned components can be walked as aligned arrays.
+    template <typename... Observed, typename... Owned>
+    class Group<Observe<Observed...>, Owned...> final : public IComponentGroup
+    {
+        static_assert(sizeof...(Owned) > 0, "Group needs at least one owned component type");
+
+    public:
+        Group(Scene *scene, std::tuple<ComponentStorage<Owned> *...> owned, std::tuple<ComponentStorage<Observed> *...> observed)
+            : m_scene(scene), m_owned(owned), m_observed(observed)
+        {
+            std::apply([this](auto *...pools)
+                       { ((pools->owner = this, pools->groups.push_back(this)), ...); },
+                       m_owned);
+            std::apply([this](auto *...pools)
+                       { (pools->groups.push_back(this), ...); },
+                       m_observed);
+
+            const auto &candidates = lead().entities();
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                onComponentAdded(candidates[i]);
+            }
+        }
+
+        std::size_t size() const
+        {
+            return m_length;
+        }
+
+        bool empty() const
+        {
+            return m_length == 0;
+        }
+
+        bool contains(EntityId id) const
+        {
+            return lead().find(id) < m_length;
+        }
+
+        // Packed entity ids, valid for [0, size()).
+        const EntityId *entities() const
+        {
+            return lead().entities().data();
+        }
+
+        // Packed owned components, index-aligned with entities().
+        template <typename T>
+        T *raw()
+        {
+            return std::get<ComponentStorage<T> *>(m_owned)->data();
+        }
+
+        // Calls func(Entity, Owned &..., Observed &...) or func(Owned &..., Observed &...).
+        template <typename Func>
+        void each(Func &&func)
+        {
+            for (std::size_t i = 0; i < m_length; ++i)
+            {
+                visit(func, i);
+            }
+        }
+
+        // Like each(), but splits the packed range into fixed chunks run on the scene's thread
+        // pool. func must only touch the entity it is given; falls back to each() without a pool.
+        template <typename Func>
+        void parallel_for_each(Func &&func);
+
+        void onComponentAdded(EntityId id) override
+        {
+            if (contains(id) || !matches(id))
+            {
+                return;
+            }
+
+            const auto target = static_cast<std::uint32_t>(m_length);
+            std::apply([id, target](auto *...pools)
+                       { (pools->swapSlots(pools->find(id), target), ...); },
+                       m_owned);
+            ++m_length;
+        }
+
+        void onComponentRemoving(EntityId id) override
+        {
+            if (!contains(id))
+            {
+                return;
+            }
+
+            --m_length;
+            const auto target = static_cast<std::uint32_t>(m_length);
+            std::apply([id, target](auto *...pools)
+                       { (pools->swapSlots(pools->find(id), target), ...); },
+                       m_owned);
+        }
+
+    private:
+        template <typename Func>
+        void visit(Func &func, std::size_t i)
+        {
+            const EntityId id = entities()[i];
+            if constexpr (std::is_invocable_v<Func &, Entity, Owned &..., Observed &...>)
+            {
+                func(Entity(m_scene, id), raw<Owned>()[i]..., *std::get<ComponentStorage<Observed> *>(m_observed)->tryGet(id)...);
+            }
+            else
+            {
+                func(raw<Owned>()[i]..., *std::get<ComponentStorage<Observed> *>(m_observed)->tryGet(id)...);
+            }
+        }
+
+        using Lead = std::tuple_element_t<0, std::tuple<Owned...>>;
+
+        const ComponentStorage<Lead> &lead() const
+        {
+            return *std::get<0>(m_owned);
+        }
+
+        bool matches(EntityId id) const
+        {
+            const bool owned = std::apply([id](auto *...pools)
+                                          { return (... && pools->has(id)); },
+                                          m_owned);
+            const bool observed = std::apply([id](auto *...pools)
+                                             { return (true && ... && pools->has(id)); },
+                                             m_observed);
+            return owned && observed;
+        }
+
+        Scene *m_scene = nullptr;
+        std::tuple<ComponentStorage<Owned> *...> m_owned;
+        std::tuple<ComponentStorage<Observed> *...> m_observed;
+        std::size_t m_length = 0;
+    };
+}
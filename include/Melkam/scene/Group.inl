@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Melkam
+{
+    template <typename... Observed, typename... Owned>
+    template <typename Func>
+    void Group<Observe<Observed...>, Owned...>::parallel_for_each(Func &&func)
+    {
+        constexpr std::size_t chunkSize = ParallelChunkSize<Owned..., Observed...>();
+        ThreadPool *pool = m_scene ? m_scene->threadPool() : nullptr;
+        if (!pool || pool->workerCount() == 0 || m_length <= chunkSize)
+        {
+            each(func);
+            return;
+        }
+
+        pool->parallelFor(m_length, chunkSize,
+                          [this, &func](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t i = begin; i < end; ++i)
+                              {
+                                  visit(func, i);
+                              }
+                          });
+    }
+}
@@ -1,20 +1,37 @@
 #pragma once
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
-#include <typeindex>
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <Melkam/core/Logger.hpp>
+#include <Melkam/core/ThreadPool.hpp>
+
+#include "CommandBuffer.hpp"
+#include "ComponentStorage.hpp"
 #include "Components.hpp"
 #include "Entity.hpp"
+#include "Group.hpp"
+#include "System.hpp"
+#include "SystemScheduler.hpp"
+#include "View.hpp"
 
 namespace Melkam
 {
-    class System;
+    template <typename T>
+    struct IsStdFunction : std::false_type
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct IsStdFunction<std::function<R(Args...)>> : std::true_type
+    {
+    };
 
     class Scene
     {
@@ -29,6 +46,7 @@ namespace Melkam
         Entity createEntity(const std::string &name = "Entity");
         Entity createChild(Entity parent, const std::string &name = "Entity");
         void destroyEntity(Entity entity);
+        void destroyEntities(std::vector<EntityId> ids);
 
         void setParent(Entity child, Entity parent);
         std::vector<Entity> rootEntities() const;
@@ -36,12 +54,83 @@ namespace Melkam
         bool isValid(EntityId id) const;
 
         void update(float dt);
-        void traverse(const std::function<void(Entity &)> &pre,
-                  const std::function<void(Entity &)> &post);
+
+        // Refreshes WorldTransformComponent for entities whose local transform or ancestors changed.
+        // Every node's local TRS is compared each call, since components are written through plain
+        // references; only changed entities and their descendants rebuild matrices. Runs at the
+        // start of update(); call it again before reading world matrices mid-frame.
+        void updateWorldTransforms();
+
+        // Depth-first walk: pre(entity) on the way down, post(entity) on the way up. Visitors can
+        // be any callable taking Entity &, an empty std::function or nullptr. Reads a cached order
+        // that is rebuilt after hierarchy changes; changes made while walking show up next time.
+        template <typename Pre, typename Post>
+        void traverse(Pre &&pre, Post &&post)
+        {
+            const auto &order = traversalOrder();
+            ++m_traversalDepth;
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                const TraversalStep step = order[i];
+                if (!isValid(step.id))
+                {
+                    continue;
+                }
+
+                Entity entity(this, step.id);
+                if (step.post)
+                {
+                    visitNode(post, entity);
+                }
+                else
+                {
+                    visitNode(pre, entity);
+                }
+            }
+            --m_traversalDepth;
+        }
+
+        // Deferred structural changes; safe to record from callbacks and systems mid-iteration.
+        // Played back at the end of update(), or on demand via flushCommands().
+        CommandBuffer &commands();
+        void flushCommands();
 
         void addSystem(std::unique_ptr<System> system);
         void clearSystems();
 
+        // Pool used to run non-conflicting systems concurrently; nullptr runs them in order.
+        void setThreadPool(ThreadPool *pool);
+        ThreadPool *threadPool() const;
+
+        // Incremented at the start of every update(); lets per-frame caches tell when they are stale.
+        std::uint64_t frame() const;
+
+        // Per-scene instance of T (physics world, caches), default-constructed on first use and
+        // destroyed by clear() or with the scene. Create it on the main thread before parallel systems read it.
+        template <typename T>
+        T &context()
+        {
+            const ComponentTypeId type = componentTypeId<T>();
+            if (type >= m_context.size())
+            {
+                m_context.resize(type + 1);
+            }
+
+            auto &slot = m_context[type];
+            if (!slot)
+            {
+                slot = std::make_unique<ContextValue<T>>();
+            }
+            return static_cast<ContextValue<T> *>(slot.get())->value;
+        }
+
+        template <typename T>
+        T *tryContext()
+        {
+            const ComponentTypeId type = componentTypeId<T>();
+            return type < m_context.size() && m_context[type] ? &static_cast<ContextValue<T> *>(m_context[type].get())->value : nullptr;
+        }
+
         void setBuilder(Builder builder);
         bool rebuild();
         void clear();
@@ -50,35 +139,55 @@ namespace Melkam
         T &createSystem(Args &&...args)
         {
             auto system = std::make_unique<T>(std::forward<Args>(args)...);
+            system->setHooks(DetectSystemHooks<T>());
             auto *ptr = system.get();
             addSystem(std::move(system));
             return *ptr;
         }
 
         template <typename... Components>
-        std::vector<Entity> view() const
+        View<Components...> view() const
+        {
+            auto *self = const_cast<Scene *>(this);
+            return View<Components...>(self, self->findStorage<Components>()...);
+        }
+
+        // Returns the owning group for Owned..., creating it on first use. Returns nullptr when one
+        // of the Owned types is already owned by a different group.
+        template <typename... Owned, typename... Observed>
+        Group<Observe<Observed...>, Owned...> *group(Observe<Observed...> = {})
         {
-            std::vector<Entity> result;
-            for (EntityId id : m_entities)
+            using GroupType = Group<Observe<Observed...>, Owned...>;
+
+            auto owned = std::make_tuple(&getOrCreateStorage<Owned>()...);
+            auto observed = std::make_tuple(&getOrCreateStorage<Observed>()...);
+            if (auto *existing = std::get<0>(owned)->owner)
             {
-                if ((hasComponent<Components>(id) && ...))
+                if (auto *match = dynamic_cast<GroupType *>(existing))
                 {
-                    result.emplace_back(const_cast<Scene *>(this), id);
+                    return match;
                 }
             }
-            return result;
+
+            const bool available = std::apply([](auto *...pools)
+                                              { return (... && (pools->owner == nullptr)); },
+                                              owned);
+            if (!available)
+            {
+                Logger::Warn("Scene::group: component type is already owned by another group.");
+                return nullptr;
+            }
+
+            auto group = std::make_unique<GroupType>(this, owned, observed);
+            auto *ptr = group.get();
+            m_groups.push_back(std::move(group));
+            return ptr;
         }
 
         template <typename T, typename... Args>
         T &addComponent(EntityId id, Args &&...args)
         {
-            auto &storage = getOrCreateStorage<T>();
-            auto result = storage.data.emplace(id, T(std::forward<Args>(args)...));
-            if (!result.second)
-            {
-                result.first->second = T(std::forward<Args>(args)...);
-            }
-            return result.first->second;
+            return getOrCreateStorage<T>().emplace(id, std::forward<Args>(args)...);
         }
 
         template <typename T>
@@ -92,103 +201,181 @@ namespace Melkam
         T *tryGetComponent(EntityId id)
         {
             auto *storage = findStorage<T>();
-            if (!storage)
-            {
-                return nullptr;
-            }
-            auto it = storage->data.find(id);
-            return it == storage->data.end() ? nullptr : &it->second;
+            return storage ? storage->tryGet(id) : nullptr;
         }
 
         template <typename T>
         const T *tryGetComponent(EntityId id) const
         {
             const auto *storage = findStorage<T>();
-            if (!storage)
+            return storage ? storage->tryGet(id) : nullptr;
+        }
+
+        template <typename T>
+        void removeComponent(EntityId id)
+        {
+            auto *storage = findStorage<T>();
+            if (storage)
             {
-                return nullptr;
+                storage->remove(id);
             }
-            auto it = storage->data.find(id);
-            return it == storage->data.end() ? nullptr : &it->second;
         }
 
         template <typename T>
-        void removeComponent(EntityId id)
+        void removeComponents(const std::vector<EntityId> &ids)
         {
             auto *storage = findStorage<T>();
             if (storage)
             {
-                storage->data.erase(id);
+                storage->removeMany(ids);
             }
         }
 
+        // Sum of the pools' add/remove counters: it changes whenever any of them gains, replaces or
+        // loses a component, so a cache over that component set can tell when to rescan.
+        template <typename... Components>
+        std::uint64_t revision() const
+        {
+            return (m_revisionBase + ... + poolRevision<Components>());
+        }
+
+        // Grows T's pool so the next `additional` adds do not reallocate.
+        template <typename T>
+        void reserveComponents(std::size_t additional)
+        {
+            auto &storage = getOrCreateStorage<T>();
+            storage.reserve(storage.size() + additional);
+        }
+
     private:
-        struct IComponentStorage
+        struct ContextSlot
         {
-            virtual ~IComponentStorage() = default;
-            virtual void remove(EntityId id) = 0;
-            virtual bool has(EntityId id) const = 0;
+            virtual ~ContextSlot() = default;
         };
 
         template <typename T>
-        struct ComponentStorage : IComponentStorage
+        struct ContextValue : ContextSlot
+        {
+            T value;
+        };
+
+        struct TraversalStep
         {
-            std::unordered_map<EntityId, T> data;
+            EntityId id = InvalidEntity;
+            bool post = false;
+        };
 
-            void remove(EntityId id) override
+        template <typename Visitor>
+        static void visitNode(Visitor &visitor, Entity &entity)
+        {
+            using Type = std::decay_t<Visitor>;
+            if constexpr (std::is_same_v<Type, std::nullptr_t>)
             {
-                data.erase(id);
+                return;
             }
-
-            bool has(EntityId id) const override
+            else if constexpr (IsStdFunction<Type>::value)
             {
-                return data.find(id) != data.end();
+                if (visitor)
+                {
+                    visitor(entity);
+                }
             }
-        };
+            else
+            {
+                visitor(entity);
+            }
+        }
 
         template <typename T>
         ComponentStorage<T> &getOrCreateStorage()
         {
-            const auto type = std::type_index(typeid(T));
-            auto it = m_components.find(type);
-            if (it == m_components.end())
+            const ComponentTypeId type = componentTypeId<T>();
+            if (type >= m_components.size())
+            {
+                m_components.resize(type + 1);
+            }
+
+            auto &slot = m_components[type];
+            if (!slot)
             {
-                auto storage = std::make_unique<ComponentStorage<T>>();
-                auto *ptr = storage.get();
-                m_components.emplace(type, std::move(storage));
-                return *ptr;
+                slot = std::make_unique<ComponentStorage<T>>();
             }
-            return *static_cast<ComponentStorage<T> *>(it->second.get());
+            return *static_cast<ComponentStorage<T> *>(slot.get());
         }
 
         template <typename T>
         ComponentStorage<T> *findStorage()
         {
-            const auto type = std::type_index(typeid(T));
-            auto it = m_components.find(type);
-            return it == m_components.end() ? nullptr : static_cast<ComponentStorage<T> *>(it->second.get());
+            const ComponentTypeId type = componentTypeId<T>();
+            return type < m_components.size() ? static_cast<ComponentStorage<T> *>(m_components[type].get()) : nullptr;
         }
 
         template <typename T>
         const ComponentStorage<T> *findStorage() const
         {
-            const auto type = std::type_index(typeid(T));
-            auto it = m_components.find(type);
-            return it == m_components.end() ? nullptr : static_cast<const ComponentStorage<T> *>(it->second.get());
+            const ComponentTypeId type = componentTypeId<T>();
+            return type < m_components.size() ? static_cast<const ComponentStorage<T> *>(m_components[type].get()) : nullptr;
+        }
+
+        template <typename T>
+        std::uint64_t poolRevision() const
+        {
+            const auto *storage = findStorage<T>();
+            return storage ? storage->revision : 0;
         }
 
         std::string m_name;
-        EntityId m_nextId = InvalidEntity;
-        std::vector<EntityId> m_entities;
-        std::unordered_set<EntityId> m_entitySet;
-        std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>> m_components;
+        std::vector<std::uint32_t> m_versions;
+        std::vector<std::uint32_t> m_freeSlots;
+        // Indexed by componentTypeId<T>(); null for types this scene never stored.
+        std::vector<std::unique_ptr<IComponentStorage>> m_components;
+        std::vector<std::unique_ptr<IComponentGroup>> m_groups;
         std::vector<std::unique_ptr<System>> m_systems;
+        std::vector<System *> m_preUpdateSystems;
+        std::vector<System *> m_postUpdateSystems;
+        SystemScheduler m_scheduler;
+        ThreadPool *m_threadPool = nullptr;
+        CommandBuffer m_commands;
         Builder m_builder;
 
-        void traverseRecursive(Entity entity,
-                               const std::function<void(Entity &)> &pre,
-                               const std::function<void(Entity &)> &post);
+        struct WorldTransformEntry
+        {
+            EntityId id = InvalidEntity;
+            std::uint32_t parent = 0;
+        };
+
+        // Bumped on every hierarchy change; the caches below remember the version they were built from.
+        std::uint64_t m_hierarchyVersion = 1;
+
+        // Pre/post events of a depth-first walk.
+        std::vector<TraversalStep> m_traversalOrder;
+        std::vector<std::pair<EntityId, std::size_t>> m_traversalStack;
+        std::uint64_t m_traversalVersion = 0;
+        int m_traversalDepth = 0;
+
+        // Breadth-first node order with parent positions, so parents are always resolved first.
+        std::vector<WorldTransformEntry> m_worldOrder;
+        std::vector<std::uint8_t> m_worldDirty;
+        std::uint64_t m_worldOrderVersion = 0;
+
+        std::uint64_t m_frame = 0;
+        // Total of the pools' revisions when clear() dropped them, so revision() never repeats a value.
+        std::uint64_t m_revisionBase = 0;
+
+        // Indexed by componentTypeId<T>(), like m_components. Declared last so contexts are destroyed
+        // before the pools they may reference.
+        std::vector<std::unique_ptr<ContextSlot>> m_context;
+
+        void prepareSchedule();
+        void unlinkNode(EntityId id);
+        void releaseSlot(std::uint32_t index);
+        void bumpVersion(std::uint32_t index);
+        const std::vector<TraversalStep> &traversalOrder();
+        void rebuildWorldOrder();
     };
 }
 
+#include "CommandBuffer.inl"
 #include "Entity.inl"
+#include "Group.inl"
+#include "View.inl"
@@ -1,10 +1,116 @@
 #pragma once
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "ComponentStorage.hpp"
 
 namespace Melkam
 {
     class Scene;
     class Entity;
 
+    // Components a system's onUpdate touches. The scheduler runs systems with disjoint
+    // write sets concurrently; a system that declares nothing is run on its own.
+    class SystemAccess
+    {
+    public:
+        struct Entry
+        {
+            ComponentTypeId type = 0;
+            bool write = false;
+            std::unique_ptr<IComponentStorage> (*makeStorage)() = nullptr;
+        };
+
+        template <typename... Components>
+        SystemAccess &read()
+        {
+            (add<Components>(false), ...);
+            return *this;
+        }
+
+        template <typename... Components>
+        SystemAccess &write()
+        {
+            (add<Components>(true), ...);
+            return *this;
+        }
+
+        // Keeps onUpdate on the thread that calls Scene::update (rendering, window input).
+        SystemAccess &pinToMainThread()
+        {
+            m_mainThread = true;
+            return *this;
+        }
+
+        bool mainThread() const
+        {
+            return m_mainThread;
+        }
+
+        bool exclusive() const
+        {
+            return m_entries.empty();
+        }
+
+        const std::vector<Entry> &entries() const
+        {
+            return m_entries;
+        }
+
+        bool conflictsWith(const SystemAccess &other) const
+        {
+            if (exclusive() || other.exclusive())
+            {
+                return true;
+            }
+
+            for (const auto &mine : m_entries)
+            {
+                for (const auto &theirs : other.m_entries)
+                {
+                    if (mine.type == theirs.type && (mine.write || theirs.write))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        template <typename T>
+        void add(bool write)
+        {
+            const ComponentTypeId type = componentTypeId<T>();
+            for (auto &entry : m_entries)
+            {
+                if (entry.type == type)
+                {
+                    entry.write = entry.write || write;
+                    return;
+                }
+            }
+
+            m_entries.push_back({type, write, []() -> std::unique_ptr<IComponentStorage>
+                                 { return std::make_unique<ComponentStorage<T>>(); }});
+        }
+
+        std::vector<Entry> m_entries;
+        bool m_mainThread = false;
+    };
+
+    // Which System callbacks a system implements; the scene only dispatches those.
+    enum class SystemHooks : std::uint32_t
+    {
+        None = 0,
+        Update = 1u << 0,
+        PreUpdate = 1u << 1,
+        PostUpdate = 1u << 2,
+        All = Update | PreUpdate | PostUpdate
+    };
+
     class System
     {
     public:
@@ -13,5 +119,61 @@ namespace Melkam
         virtual void onUpdate(Scene &scene, float dt) {}
         virtual void onPreUpdate(Scene &scene, Entity &entity, float dt) {}
         virtual void onPostUpdate(Scene &scene, Entity &entity, float dt) {}
+
+        // Scene::createSystem<T> detects overrides itself; systems handed to addSystem keep
+        // All unless they narrow it before registration.
+        std::uint32_t hooks() const
+        {
+            return m_hooks;
+        }
+
+        bool hasHook(SystemHooks hook) const
+        {
+            return (m_hooks & static_cast<std::uint32_t>(hook)) != 0u;
+        }
+
+        void setHooks(std::uint32_t hooks)
+        {
+            m_hooks = hooks;
+        }
+
+        const SystemAccess &access() const
+        {
+            return m_access;
+        }
+
+    protected:
+        // Declare from the constructor. Systems running off the main thread must route
+        // structural changes through Scene::commands().
+        SystemAccess &declareAccess()
+        {
+            return m_access;
+        }
+
+    private:
+        SystemAccess m_access;
+        std::uint32_t m_hooks = static_cast<std::uint32_t>(SystemHooks::All);
     };
+
+    // Hooks T overrides: &T::onX still has type void (System::*)(...) when T inherits the no-op.
+    template <typename T>
+    constexpr std::uint32_t DetectSystemHooks()
+    {
+        static_assert(std::is_base_of_v<System, T>, "T must derive from System");
+
+        std::uint32_t hooks = 0;
+        if constexpr (!std::is_same_v<decltype(&T::onUpdate), void (System::*)(Scene &, float)>)
+        {
+            hooks |= static_cast<std::uint32_t>(SystemHooks::Update);
+        }
+        if constexpr (!std::is_same_v<decltype(&T::onPreUpdate), void (System::*)(Scene &, Entity &, float)>)
+        {
+            hooks |= static_cast<std::uint32_t>(SystemHooks::PreUpdate);
+        }
+        if constexpr (!std::is_same_v<decltype(&T::onPostUpdate), void (System::*)(Scene &, Entity &, float)>)
+        {
+            hooks |= static_cast<std::uint32_t>(SystemHooks::PostUpdate);
+        }
+        return hooks;
+    }
 }
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Melkam
+{
+    class Scene;
+    class System;
+    class ThreadPool;
+
+    // Splits systems into stages whose members do not conflict on component access. Conflicting
+    // systems keep their registration order: each lands one stage after the last earlier system
+    // it conflicts with. Stages run in order; members of a stage run concurrently on the pool.
+    class SystemScheduler
+    {
+    public:
+        void invalidate();
+        bool dirty() const;
+
+        void rebuild(const std::vector<std::unique_ptr<System>> &systems);
+        void run(Scene &scene, const std::vector<std::unique_ptr<System>> &systems, ThreadPool *pool, float dt);
+
+    private:
+        struct Stage
+        {
+            std::vector<std::size_t> members;
+            std::size_t mainThreadCount = 0;
+        };
+
+        std::vector<Stage> m_stages;
+        bool m_dirty = true;
+    };
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <Melkam/core/AlignedArray.hpp>
+#include <Melkam/math/Vector.hpp>
+
+#include "Entity.hpp"
+
+namespace Melkam
+{
+    class Scene;
+
+    // Optional structure-of-arrays pool of positions, velocities and half extents, one
+    // 32-byte aligned float array per axis. Large homogeneous sets (particles, crowds) can
+    // live here directly, or be mirrored from the scene with gather()/scatter(), which is what
+    // the system added by RegisterBatchIntegrationSystem does every frame.
+    class TransformSoA
+    {
+    public:
+        void reserve(std::size_t capacity);
+        void clear();
+
+        // Returns the slot index. id may be InvalidEntity for bodies that have no entity.
+        std::size_t add(EntityId id, const Vector3f &position, const Vector3f &velocity = {0.0f, 0.0f, 0.0f},
+                        const Vector3f &halfExtents = {0.5f, 0.5f, 0.5f});
+
+        // Rebuilds the pool from every entity with a TransformComponent and a Velocity2DComponent
+        // or Velocity3DComponent that the physics systems do not move: no ColliderComponent, and
+        // no BoxShape2DComponent next to a Velocity2DComponent. Half extents come from
+        // BoxShape3DComponent when present.
+        void gather(Scene &scene);
+
+        // Writes positions back to the TransformComponent of each slot that has an entity.
+        void scatter(Scene &scene) const;
+
+        // position += velocity * dt for every slot, one axis at a time.
+        void integrate(float dt);
+
+        // Fills the min/max arrays from the current positions and half extents.
+        void buildAabbs();
+
+        std::size_t size() const
+        {
+            return m_ids.size();
+        }
+
+        const std::vector<EntityId> &entities() const
+        {
+            return m_ids;
+        }
+
+        // Axis 0..2 accessors; all arrays have size() elements.
+        float *position(std::size_t axis)
+        {
+            return m_position[axis].data();
+        }
+
+        const float *position(std::size_t axis) const
+        {
+            return m_position[axis].data();
+        }
+
+        float *velocity(std::size_t axis)
+        {
+            return m_velocity[axis].data();
+        }
+
+        const float *velocity(std::size_t axis) const
+        {
+            return m_velocity[axis].data();
+        }
+
+        float *halfExtents(std::size_t axis)
+        {
+            return m_half[axis].data();
+        }
+
+        const float *aabbMin(std::size_t axis) const
+        {
+            return m_min[axis].data();
+        }
+
+        const float *aabbMax(std::size_t axis) const
+        {
+            return m_max[axis].data();
+        }
+
+    private:
+        std::vector<EntityId> m_ids;
+        AlignedArray<float> m_position[3];
+        AlignedArray<float> m_velocity[3];
+        AlignedArray<float> m_half[3];
+        AlignedArray<float> m_min[3];
+        AlignedArray<float> m_max[3];
+    };
+
+    // Opt-in system that moves the entities gather() picks up by their velocity each frame,
+    // through the batch kernels instead of one TransformComponent at a time.
+    void RegisterBatchIntegrationSystem(Scene &scene);
+}
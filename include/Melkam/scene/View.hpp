@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+
+namespace Melkam
+{
+    class Scene;
+
+    // Entities per parallel chunk: roughly 16 KiB of component data, never fewer than 64.
+    template <typename... Components>
+    constexpr std::size_t ParallelChunkSize()
+    {
+        constexpr std::size_t bytes = (sizeof(EntityId) + ... + sizeof(Components));
+        return std::max<std::size_t>(64, 16384 / bytes);
+    }
+
+    // Non-owning, allocation-free view. Walks the smallest participating pool and
+    // checks membership in the others; structural changes while iterating are unsafe.
+    template <typename... Components>
+    class View
+    {
+        static_assert(sizeof...(Components) > 0, "View needs at least one component type");
+
+    public:
+        class Iterator
+        {
+        public:
+            Iterator() = default;
+            Iterator(const View *view, std::size_t index) : m_view(view), m_index(index)
+            {
+                settle();
+            }
+
+            Entity &operator*()
+            {
+                return m_current;
+            }
+
+            Entity *operator->()
+            {
+                return &m_current;
+            }
+
+            Iterator &operator++()
+            {
+                ++m_index;
+                settle();
+                return *this;
+            }
+
+            bool operator==(const Iterator &other) const
+            {
+                const bool endA = atEnd();
+                const bool endB = other.atEnd();
+                if (endA || endB)
+                {
+                    return endA == endB;
+                }
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(const Iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            bool atEnd() const
+            {
+                return !m_view || !m_view->m_candidates || m_index >= m_view->m_candidates->size();
+            }
+
+            void settle()
+            {
+                while (!atEnd())
+                {
+                    const EntityId id = (*m_view->m_candidates)[m_index];
+                    if (m_view->contains(id))
+                    {
+                        m_current = Entity(m_view->m_scene, id);
+                        return;
+                    }
+                    ++m_index;
+                }
+            }
+
+            const View *m_view = nullptr;
+            std::size_t m_index = 0;
+            Entity m_current;
+        };
+
+        View(Scene *scene, ComponentStorage<Components> *...storages)
+            : m_scene(scene), m_storages(storages...)
+        {
+            if ((... && storages))
+            {
+                const IComponentStorage *pools[] = {storages...};
+                const std::vector<EntityId> *candidates[] = {&storages->entities()...};
+                std::size_t best = 0;
+                for (std::size_t i = 1; i < sizeof...(Components); ++i)
+                {
+                    if (pools[i]->size() < pools[best]->size())
+                    {
+                        best = i;
+                    }
+                }
+                m_candidates = candidates[best];
+            }
+        }
+
+        Iterator begin() const
+        {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const
+        {
+            return Iterator();
+        }
+
+        bool contains(EntityId id) const
+        {
+            return std::apply([id](auto *...storages)
+                              { return (... && storages->has(id)); },
+                              m_storages);
+        }
+
+        // Upper bound on the number of entities the view yields.
+        std::size_t sizeHint() const
+        {
+            return m_candidates ? m_candidates->size() : 0;
+        }
+
+        // Calls func(Entity, Components &...) or func(Components &...) for every match.
+        template <typename Func>
+        void each(Func &&func) const
+        {
+            if (!m_candidates)
+            {
+                return;
+            }
+
+            for (std::size_t i = 0; i < m_candidates->size(); ++i)
+            {
+                visit(func, (*m_candidates)[i]);
+            }
+        }
+
+        // Like each(), but splits the walk into fixed chunks run on the scene's thread pool.
+        // func must only touch the entity it is given; falls back to each() without a pool.
+        template <typename Func>
+        void parallel_for_each(Func &&func) const;
+
+        private:
+        template <typename Func>
+        void visit(Func &func, EntityId id) const
+        {
+            if (!contains(id))
+            {
+                return;
+            }
+
+            if constexpr (std::is_invocable_v<Func &, Entity, Components &...>)
+            {
+                func(Entity(m_scene, id), *std::get<ComponentStorage<Components> *>(m_storages)->tryGet(id)...);
+            }
+            else
+            {
+                func(*std::get<ComponentStorage<Components> *>(m_storages)->tryGet(id)...);
+            }
+        }
+
+        Scene *m_scene = nullptr;
+        std::tuple<ComponentStorage<Components> *...> m_storages;
+        const std::vector<EntityId> *m_candidates = nullptr;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Melkam
+{
+    template <typename... Components>
+    template <typename Func>
+    void View<Components...>::parallel_for_each(Func &&func) const
+    {
+        constexpr std::size_t chunkSize = ParallelChunkSize<Components...>();
+        ThreadPool *pool = m_scene ? m_scene->threadPool() : nullptr;
+        if (!pool || pool->workerCount() == 0 || sizeHint() <= chunkSize)
+        {
+            each(func);
+            return;
+        }
+
+        pool->parallelFor(m_candidates->size(), chunkSize,
+                          [this, &func](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t i = begin; i < end; ++i)
+                              {
+                                  visit(func, (*m_candidates)[i]);
+                              }
+                          });
+    }
+}
@@ -1,5 +1,6 @@
 #include <Melkam/core/Engine.hpp>
 #include <Melkam/core/Application.hpp>
+#include <Melkam/core/ThreadPool.hpp>
 #include <Melkam/scene/Scene.hpp>
 #include <chrono>
 
@@ -19,6 +20,13 @@ namespace Melkam
     void Engine::init()
     {
         m_window = std::make_unique<Window>(*this);
+
+        const std::size_t workers = m_config.workerThreads < 0 ? ThreadPool::defaultWorkerCount()
+                                                               : static_cast<std::size_t>(m_config.workerThreads);
+        if (workers > 0)
+        {
+            m_threadPool = std::make_unique<ThreadPool>(workers);
+        }
     }
 
     void Engine::cleanup()
@@ -26,6 +34,14 @@ namespace Melkam
         m_window.reset();
     }
 
+    void Engine::attachScene(const std::shared_ptr<Scene> &scene)
+    {
+        if (scene && !scene->threadPool())
+        {
+            scene->setThreadPool(m_threadPool.get());
+        }
+    }
+
     void Engine::shutdown()
     {
         m_state = EngineState::ShuttingDown;
@@ -79,6 +95,7 @@ namespace Melkam
     std::shared_ptr<Scene> Engine::createScene(const std::string &name)
     {
         auto scene = std::make_shared<Scene>(name);
+        attachScene(scene);
         if (!m_activeScene)
         {
             m_activeScene = scene;
@@ -88,6 +105,7 @@ namespace Melkam
 
     void Engine::setActiveScene(const std::shared_ptr<Scene> &scene)
     {
+        attachScene(scene);
         m_activeScene = scene;
     }
 
@@ -98,6 +116,7 @@ namespace Melkam
 
     void Engine::requestSceneChange(const std::shared_ptr<Scene> &scene)
     {
+        attachScene(scene);
         m_pendingScene = scene;
     }
 
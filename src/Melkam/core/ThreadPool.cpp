@@ -0,0 +1,155 @@
+#include <Melkam/core/ThreadPool.hpp>
+
+#include <algorithm>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Queue owned by the current thread, or NoQueue for threads outside the pool.
+        constexpr std::size_t NoQueue = static_cast<std::size_t>(-1);
+        thread_local const ThreadPool *t_pool = nullptr;
+        thread_local std::size_t t_queue = NoQueue;
+    }
+
+    ThreadPool::ThreadPool(std::size_t workerCount)
+    {
+        // The caller of wait() gets a queue too, so a thread-less pool still has somewhere to put work.
+        const std::size_t queueCount = std::max<std::size_t>(workerCount, 1);
+        m_queues.reserve(queueCount);
+        for (std::size_t i = 0; i < queueCount; ++i)
+        {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+
+        m_threads.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            m_threads.emplace_back([this, i]()
+                                   { workerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::size_t ThreadPool::workerCount() const
+    {
+        return m_threads.size();
+    }
+
+    void ThreadPool::submit(TaskGroup &group, Task task)
+    {
+        group.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        const bool ownQueue = t_pool == this && t_queue != NoQueue;
+        const std::size_t index = ownQueue ? t_queue : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        {
+            std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+            m_queues[index]->entries.push_back({std::move(task), &group});
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_wake.notify_one();
+    }
+
+    void ThreadPool::wait(TaskGroup &group)
+    {
+        const std::size_t home = (t_pool == this && t_queue != NoQueue) ? t_queue : 0;
+        while (!group.done())
+        {
+            if (!runOne(home))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::size_t ThreadPool::defaultWorkerCount()
+    {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    bool ThreadPool::runOne(std::size_t home)
+    {
+        Entry entry;
+        bool found = popBack(*m_queues[home], entry);
+        for (std::size_t offset = 1; !found && offset < m_queues.size(); ++offset)
+        {
+            found = stealFront(*m_queues[(home + offset) % m_queues.size()], entry);
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        entry.task();
+        entry.group->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool ThreadPool::popBack(Queue &queue, Entry &out)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.entries.empty())
+        {
+            return false;
+        }
+
+        out = std::move(queue.entries.back());
+        queue.entries.pop_back();
+        return true;
+    }
+
+    bool ThreadPool::stealFront(Queue &queue, Entry &out)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.entries.empty())
+        {
+            return false;
+        }
+
+        out = std::move(queue.entries.front());
+        queue.entries.pop_front();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(std::size_t index)
+    {
+        t_pool = this;
+        t_queue = index;
+
+        while (true)
+        {
+            if (runOne(index))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]()
+                        { return m_stopping || m_queued.load(std::memory_order_relaxed) > 0; });
+            if (m_stopping && m_queued.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,381 @@
+#include <Melkam/math/Matrix.hpp>
+
+#include <cmath>
+
+#if defined(MELKAM_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MELKAM_SIMD_SSE4)
+#include <smmintrin.h>
+#endif
+
+#if defined(MELKAM_SIMD_AVX2) || defined(MELKAM_SIMD_SSE4)
+#define MELKAM_MATH_SSE 1
+#endif
+
+// Multiply and point transforms sum the columns in the same order on every backend, so their
+// results are bit-identical. The SIMD inverse uses the 2x2 block method and matches the scalar
+// cofactor expansion only to rounding.
+
+namespace Melkam
+{
+    namespace
+    {
+#if defined(MELKAM_MATH_SSE)
+        // 2x2 blocks packed as (m00, m01, m10, m11).
+        __m128 mat2Mul(__m128 a, __m128 b)
+        {
+            return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        // adj(a) * b
+        __m128 mat2AdjMul(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        // a * adj(b)
+        __m128 mat2MulAdj(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+#endif
+
+        float determinant3(const Matrix4f &matrix)
+        {
+            const float *m = matrix.m;
+            return m[0] * (m[5] * m[10] - m[9] * m[6]) -
+                   m[4] * (m[1] * m[10] - m[9] * m[2]) +
+                   m[8] * (m[1] * m[6] - m[5] * m[2]);
+        }
+    }
+
+    Matrix4f Matrix4f::compose(const Vector3f &translation, const Vector3f &rotation, const Vector3f &scale)
+    {
+        const float cx = std::cos(rotation.x);
+        const float sx = std::sin(rotation.x);
+        const float cy = std::cos(rotation.y);
+        const float sy = std::sin(rotation.y);
+        const float cz = std::cos(rotation.z);
+        const float sz = std::sin(rotation.z);
+
+        Matrix4f result;
+        result.m[0] = (cy * cz + sy * sx * sz) * scale.x;
+        result.m[1] = (cx * sz) * scale.x;
+        result.m[2] = (cy * sx * sz - sy * cz) * scale.x;
+        result.m[3] = 0.0f;
+
+        result.m[4] = (sy * sx * cz - cy * sz) * scale.y;
+        result.m[5] = (cx * cz) * scale.y;
+        result.m[6] = (sy * sz + cy * sx * cz) * scale.y;
+        result.m[7] = 0.0f;
+
+        result.m[8] = (sy * cx) * scale.z;
+        result.m[9] = -sx * scale.z;
+        result.m[10] = (cy * cx) * scale.z;
+        result.m[11] = 0.0f;
+
+        result.m[12] = translation.x;
+        result.m[13] = translation.y;
+        result.m[14] = translation.z;
+        result.m[15] = 1.0f;
+        return result;
+    }
+
+    Matrix4f Matrix4f::compose(const Vector3f &translation, const Quaternionf &rotation, const Vector3f &scale)
+    {
+        const Quaternionf q = rotation.normalized();
+        const float xx = q.x * q.x;
+        const float yy = q.y * q.y;
+        const float zz = q.z * q.z;
+        const float xy = q.x * q.y;
+        const float xz = q.x * q.z;
+        const float yz = q.y * q.z;
+        const float wx = q.w * q.x;
+        const float wy = q.w * q.y;
+        const float wz = q.w * q.z;
+
+        Matrix4f result;
+        result.m[0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+        result.m[1] = 2.0f * (xy + wz) * scale.x;
+        result.m[2] = 2.0f * (xz - wy) * scale.x;
+        result.m[3] = 0.0f;
+
+        result.m[4] = 2.0f * (xy - wz) * scale.y;
+        result.m[5] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+        result.m[6] = 2.0f * (yz + wx) * scale.y;
+        result.m[7] = 0.0f;
+
+        result.m[8] = 2.0f * (xz + wy) * scale.z;
+        result.m[9] = 2.0f * (yz - wx) * scale.z;
+        result.m[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+        result.m[11] = 0.0f;
+
+        result.m[12] = translation.x;
+        result.m[13] = translation.y;
+        result.m[14] = translation.z;
+        result.m[15] = 1.0f;
+        return result;
+    }
+
+    bool Matrix4f::decompose(Vector3f &translation, Quaternionf &rotation, Vector3f &scale) const
+    {
+        translation = {m[12], m[13], m[14]};
+        scale = {Vector3f{m[0], m[1], m[2]}.length(),
+                 Vector3f{m[4], m[5], m[6]}.length(),
+                 Vector3f{m[8], m[9], m[10]}.length()};
+        if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+        {
+            rotation = Quaternionf::identity();
+            return false;
+        }
+
+        if (determinant3(*this) < 0.0f)
+        {
+            scale.x = -scale.x;
+        }
+
+        // r(row, col) of the pure rotation.
+        const float r00 = m[0] / scale.x, r10 = m[1] / scale.x, r20 = m[2] / scale.x;
+        const float r01 = m[4] / scale.y, r11 = m[5] / scale.y, r21 = m[6] / scale.y;
+        const float r02 = m[8] / scale.z, r12 = m[9] / scale.z, r22 = m[10] / scale.z;
+
+        const float trace = r00 + r11 + r22;
+        if (trace > 0.0f)
+        {
+            const float s = std::sqrt(trace + 1.0f) * 2.0f;
+            rotation = {(r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s, 0.25f * s};
+        }
+        else if (r00 > r11 && r00 > r22)
+        {
+            const float s = std::sqrt(1.0f + r00 - r11 - r22) * 2.0f;
+            rotation = {0.25f * s, (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s};
+        }
+        else if (r11 > r22)
+        {
+            const float s = std::sqrt(1.0f + r11 - r00 - r22) * 2.0f;
+            rotation = {(r01 + r10) / s, 0.25f * s, (r12 + r21) / s, (r02 - r20) / s};
+        }
+        else
+        {
+            const float s = std::sqrt(1.0f + r22 - r00 - r11) * 2.0f;
+            rotation = {(r02 + r20) / s, (r12 + r21) / s, 0.25f * s, (r10 - r01) / s};
+        }
+
+        rotation = rotation.normalized();
+        return true;
+    }
+
+    Matrix4f Matrix4f::operator*(const Matrix4f &other) const
+    {
+        Matrix4f result;
+#if defined(MELKAM_SIMD_AVX2)
+        // Two result columns per iteration; each 128-bit lane picks its own column of other.
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 12));
+        for (int col = 0; col < 4; col += 2)
+        {
+            const __m256 b = _mm256_loadu_ps(other.m + col * 4);
+            __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm256_storeu_ps(result.m + col * 4, r);
+        }
+#elif defined(MELKAM_MATH_SSE)
+        const __m128 a0 = _mm_load_ps(m);
+        const __m128 a1 = _mm_load_ps(m + 4);
+        const __m128 a2 = _mm_load_ps(m + 8);
+        const __m128 a3 = _mm_load_ps(m + 12);
+        for (int col = 0; col < 4; ++col)
+        {
+            const float *b = other.m + col * 4;
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[3])));
+            _mm_store_ps(result.m + col * 4, r);
+        }
+#else
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                result.m[col * 4 + row] = m[row] * other.m[col * 4] +
+                                          m[4 + row] * other.m[col * 4 + 1] +
+                                          m[8 + row] * other.m[col * 4 + 2] +
+                                          m[12 + row] * other.m[col * 4 + 3];
+            }
+        }
+#endif
+        return result;
+    }
+
+    Matrix4f Matrix4f::inverse() const
+    {
+        Matrix4f result;
+#if defined(MELKAM_MATH_SSE)
+        // Block inverse over the 2x2 sub-matrices of the columns. Works on the transpose, which
+        // is fine: inverse(transpose(M)) == transpose(inverse(M)).
+        const __m128 c0 = _mm_load_ps(m);
+        const __m128 c1 = _mm_load_ps(m + 4);
+        const __m128 c2 = _mm_load_ps(m + 8);
+        const __m128 c3 = _mm_load_ps(m + 12);
+
+        const __m128 A = _mm_movelh_ps(c0, c1);
+        const __m128 B = _mm_movehl_ps(c1, c0);
+        const __m128 C = _mm_movelh_ps(c2, c3);
+        const __m128 D = _mm_movehl_ps(c3, c2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+        const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+        const __m128 adjDC = mat2AdjMul(D, C);
+        const __m128 adjAB = mat2AdjMul(A, B);
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, adjDC));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, adjAB));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, adjAB));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, adjDC));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+        __m128 trace = _mm_mul_ps(adjAB, _mm_shuffle_ps(adjDC, adjDC, _MM_SHUFFLE(3, 1, 2, 0)));
+        trace = _mm_hadd_ps(trace, trace);
+        trace = _mm_hadd_ps(trace, trace);
+        const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+        if (_mm_cvtss_f32(detM) == 0.0f)
+        {
+            return identity();
+        }
+
+        const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        X = _mm_mul_ps(X, rDetM);
+        Y = _mm_mul_ps(Y, rDetM);
+        Z = _mm_mul_ps(Z, rDetM);
+        W = _mm_mul_ps(W, rDetM);
+
+        _mm_store_ps(result.m, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_store_ps(result.m + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_store_ps(result.m + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_store_ps(result.m + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+#else
+        // Cofactor expansion; the layout does not matter for the same reason as above.
+        float inv[16];
+        inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+        if (det == 0.0f)
+        {
+            return identity();
+        }
+
+        const float invDet = 1.0f / det;
+        for (int i = 0; i < 16; ++i)
+        {
+            result.m[i] = inv[i] * invDet;
+        }
+#endif
+        return result;
+    }
+
+    Matrix4f Matrix4f::transposed() const
+    {
+        Matrix4f result;
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                result.m[row * 4 + col] = m[col * 4 + row];
+            }
+        }
+        return result;
+    }
+
+    Vector3f Matrix4f::transformPoint(const Vector3f &point) const
+    {
+        Vector3f result;
+        TransformPoints(*this, &point, &result, 1);
+        return result;
+    }
+
+    Vector3f Matrix4f::transformVector(const Vector3f &vector) const
+    {
+        return {m[0] * vector.x + m[4] * vector.y + m[8] * vector.z,
+                m[1] * vector.x + m[5] * vector.y + m[9] * vector.z,
+                m[2] * vector.x + m[6] * vector.y + m[10] * vector.z};
+    }
+
+    void TransformPoints(const Matrix4f &matrix, const Vector3f *in, Vector3f *out, std::size_t count)
+    {
+        const float *m = matrix.m;
+        std::size_t i = 0;
+#if defined(MELKAM_SIMD_AVX2)
+        const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m));
+        const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 4));
+        const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 8));
+        const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 12));
+        for (; i + 2 <= count; i += 2)
+        {
+            const Vector3f p0 = in[i];
+            const Vector3f p1 = in[i + 1];
+            __m256 r = _mm256_mul_ps(c0, _mm256_setr_ps(p0.x, p0.x, p0.x, p0.x, p1.x, p1.x, p1.x, p1.x));
+            r = _mm256_add_ps(r, _mm256_mul_ps(c1, _mm256_setr_ps(p0.y, p0.y, p0.y, p0.y, p1.y, p1.y, p1.y, p1.y)));
+            r = _mm256_add_ps(r, _mm256_mul_ps(c2, _mm256_setr_ps(p0.z, p0.z, p0.z, p0.z, p1.z, p1.z, p1.z, p1.z)));
+            r = _mm256_add_ps(r, c3);
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, r);
+            out[i] = {lanes[0], lanes[1], lanes[2]};
+            out[i + 1] = {lanes[4], lanes[5], lanes[6]};
+        }
+#elif defined(MELKAM_MATH_SSE)
+        const __m128 c0 = _mm_load_ps(m);
+        const __m128 c1 = _mm_load_ps(m + 4);
+        const __m128 c2 = _mm_load_ps(m + 8);
+        const __m128 c3 = _mm_load_ps(m + 12);
+        for (; i < count; ++i)
+        {
+            const Vector3f p = in[i];
+            __m128 r = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+            r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+            r = _mm_add_ps(r, c3);
+
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, r);
+            out[i] = {lanes[0], lanes[1], lanes[2]};
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const Vector3f p = in[i];
+            out[i] = {m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                      m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                      m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]};
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include <Melkam/math/Quaternion.hpp>
+
+#include <cmath>
+
+#if defined(MELKAM_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MELKAM_SIMD_SSE4)
+#include <smmintrin.h>
+#endif
+
+namespace Melkam
+{
+    Quaternionf Quaternionf::fromAxisAngle(const Vector3f &axis, float radians)
+    {
+        const float half = radians * 0.5f;
+        const float s = std::sin(half);
+        return {axis.x * s, axis.y * s, axis.z * s, std::cos(half)};
+    }
+
+    Quaternionf Quaternionf::fromEuler(const Vector3f &radians)
+    {
+        const Quaternionf qx = fromAxisAngle({1.0f, 0.0f, 0.0f}, radians.x);
+        const Quaternionf qy = fromAxisAngle({0.0f, 1.0f, 0.0f}, radians.y);
+        const Quaternionf qz = fromAxisAngle({0.0f, 0.0f, 1.0f}, radians.z);
+        return qy * qx * qz;
+    }
+
+    Quaternionf Quaternionf::slerp(const Quaternionf &from, const Quaternionf &to, float t)
+    {
+        float cosTheta = from.dot(to);
+        Quaternionf target = to;
+        if (cosTheta < 0.0f)
+        {
+            cosTheta = -cosTheta;
+            target = {-to.x, -to.y, -to.z, -to.w};
+        }
+
+        float wa = 1.0f - t;
+        float wb = t;
+        if (cosTheta < 0.9995f)
+        {
+            const float theta = std::acos(cosTheta);
+            const float invSin = 1.0f / std::sin(theta);
+            wa = std::sin(wa * theta) * invSin;
+            wb = std::sin(wb * theta) * invSin;
+        }
+
+        const Quaternionf result{from.x * wa + target.x * wb,
+                                 from.y * wa + target.y * wb,
+                                 from.z * wa + target.z * wb,
+                                 from.w * wa + target.w * wb};
+        return result.normalized();
+    }
+
+    // Both paths accumulate in the same order, so SIMD and scalar products are bit-identical.
+    Quaternionf Quaternionf::operator*(const Quaternionf &other) const
+    {
+#if defined(MELKAM_SIMD_AVX2) || defined(MELKAM_SIMD_SSE4)
+        const __m128 b = _mm_load_ps(&other.x);
+        const __m128 s1 = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+        const __m128 s2 = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+        const __m128 s3 = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+        __m128 r = _mm_mul_ps(_mm_set1_ps(w), b);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(x), s1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(y), s2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(z), s3));
+
+        Quaternionf result;
+        _mm_store_ps(&result.x, r);
+        return result;
+#else
+        return {w * other.x + x * other.w + y * other.z - z * other.y,
+                w * other.y - x * other.z + y * other.w + z * other.x,
+                w * other.z + x * other.y - y * other.x + z * other.w,
+                w * other.w - x * other.x - y * other.y - z * other.z};
+#endif
+    }
+
+    Vector3f Quaternionf::rotate(const Vector3f &vector) const
+    {
+        // v + w * t + q x t, with t = 2 * (q x v)
+        const Vector3f axis{x, y, z};
+        const Vector3f t = axis.cross(vector) * 2.0f;
+        return vector + t * w + axis.cross(t);
+    }
+
+    float Quaternionf::length() const
+    {
+        return std::sqrt(dot(*this));
+    }
+
+    Quaternionf Quaternionf::normalized() const
+    {
+        const float len = length();
+        if (len <= 0.0f)
+        {
+            return identity();
+        }
+
+        const float inv = 1.0f / len;
+        return {x * inv, y * inv, z * inv, w * inv};
+    }
+}
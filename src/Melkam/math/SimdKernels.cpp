@@ -0,0 +1,78 @@
+#include <Melkam/math/SimdKernels.hpp>
+
+#if defined(MELKAM_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MELKAM_SIMD_SSE4)
+#include <smmintrin.h>
+#endif
+
+// Keep mul and add separate in the scalar path as well (the build passes -ffp-contract=off),
+// otherwise an FMA-contracted tail would round differently from the vector body.
+
+namespace Melkam
+{
+    void IntegrateAxis(float *position, const float *velocity, std::size_t count, float dt)
+    {
+        std::size_t i = 0;
+#if defined(MELKAM_SIMD_AVX2)
+        const __m256 step = _mm256_set1_ps(dt);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 p = _mm256_loadu_ps(position + i);
+            const __m256 v = _mm256_loadu_ps(velocity + i);
+            _mm256_storeu_ps(position + i, _mm256_add_ps(p, _mm256_mul_ps(v, step)));
+        }
+#elif defined(MELKAM_SIMD_SSE4)
+        const __m128 step = _mm_set1_ps(dt);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 p = _mm_loadu_ps(position + i);
+            const __m128 v = _mm_loadu_ps(velocity + i);
+            _mm_storeu_ps(position + i, _mm_add_ps(p, _mm_mul_ps(v, step)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const float delta = velocity[i] * dt;
+            position[i] = position[i] + delta;
+        }
+    }
+
+    void BuildBounds(const float *center, const float *half, float *outMin, float *outMax, std::size_t count)
+    {
+        std::size_t i = 0;
+#if defined(MELKAM_SIMD_AVX2)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 c = _mm256_loadu_ps(center + i);
+            const __m256 h = _mm256_loadu_ps(half + i);
+            _mm256_storeu_ps(outMin + i, _mm256_sub_ps(c, h));
+            _mm256_storeu_ps(outMax + i, _mm256_add_ps(c, h));
+        }
+#elif defined(MELKAM_SIMD_SSE4)
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 c = _mm_loadu_ps(center + i);
+            const __m128 h = _mm_loadu_ps(half + i);
+            _mm_storeu_ps(outMin + i, _mm_sub_ps(c, h));
+            _mm_storeu_ps(outMax + i, _mm_add_ps(c, h));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            outMin[i] = center[i] - half[i];
+            outMax[i] = center[i] + half[i];
+        }
+    }
+
+    const char *SimdBackendName()
+    {
+#if defined(MELKAM_SIMD_AVX2)
+        return "AVX2";
+#elif defined(MELKAM_SIMD_SSE4)
+        return "SSE4";
+#else
+        return "Scalar";
+#endif
+    }
+}
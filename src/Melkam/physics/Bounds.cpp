@@ -0,0 +1,117 @@
+#include <Melkam/physics/Bounds.hpp>
+
+#include <Melkam/physics/CollisionMesh.hpp>
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <cmath>
+
+namespace Melkam
+{
+    bool IsStaticBody(const Entity &entity)
+    {
+        return entity.hasComponent<StaticBodyComponent>() || entity.hasComponent<StaticBody2DComponent>() ||
+               entity.hasComponent<StaticBody3DComponent>();
+    }
+
+    bool IsTriggerLike(const Entity &entity, const ColliderComponent *collider)
+    {
+        if (!collider)
+        {
+            return false;
+        }
+
+        if (collider->isTrigger)
+        {
+            return true;
+        }
+
+        if (collider->is2D)
+        {
+            return entity.tryGetComponent<Area2DComponent>() != nullptr;
+        }
+
+        return entity.tryGetComponent<Area3DComponent>() != nullptr;
+    }
+
+    Vector3f WorldPosition(const Entity &entity, const Vector3f &localPosition)
+    {
+        const auto *node = entity.tryGetComponent<NodeComponent>();
+        if (!node || node->parent == InvalidEntity || !entity.scene())
+        {
+            return localPosition;
+        }
+
+        const auto *parent = entity.scene()->tryGetComponent<WorldTransformComponent>(node->parent);
+        return parent ? parent->matrix.transformPoint(localPosition) : localPosition;
+    }
+
+    bool ComputeAabb2D(const Entity &entity, const TransformComponent &transform, Aabb2D &out)
+    {
+        const Vector3f position = WorldPosition(entity, transform.position);
+        if (const auto *box = entity.tryGetComponent<BoxShape2DComponent>())
+        {
+            const float halfX = std::abs(box->size[0]) * 0.5f;
+            const float halfY = std::abs(box->size[1]) * 0.5f;
+            out.minX = position.x - halfX;
+            out.maxX = position.x + halfX;
+            out.minY = position.y - halfY;
+            out.maxY = position.y + halfY;
+            return true;
+        }
+
+        if (const auto *circle = entity.tryGetComponent<CircleShape2DComponent>())
+        {
+            const float r = std::abs(circle->radius);
+            out.minX = position.x - r;
+            out.maxX = position.x + r;
+            out.minY = position.y - r;
+            out.maxY = position.y + r;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ComputeAabb3D(const Entity &entity, const TransformComponent &transform, Aabb3D &out)
+    {
+        const Vector3f position = WorldPosition(entity, transform.position);
+        if (const auto *box = entity.tryGetComponent<BoxShape3DComponent>())
+        {
+            const float halfX = std::abs(box->size[0]) * 0.5f;
+            const float halfY = std::abs(box->size[1]) * 0.5f;
+            const float halfZ = std::abs(box->size[2]) * 0.5f;
+            out.minX = position.x - halfX;
+            out.maxX = position.x + halfX;
+            out.minY = position.y - halfY;
+            out.maxY = position.y + halfY;
+            out.minZ = position.z - halfZ;
+            out.maxZ = position.z + halfZ;
+            return true;
+        }
+
+        if (const auto *sphere = entity.tryGetComponent<SphereShape3DComponent>())
+        {
+            const float r = std::abs(sphere->radius);
+            out.minX = position.x - r;
+            out.maxX = position.x + r;
+            out.minY = position.y - r;
+            out.maxY = position.y + r;
+            out.minZ = position.z - r;
+            out.maxZ = position.z + r;
+            return true;
+        }
+
+        // The proxy resolved the mesh once; loading it here would lock the library per call.
+        const PhysicsWorld *world = entity.scene() ? entity.scene()->tryContext<PhysicsWorld>() : nullptr;
+        const CollisionMesh *mesh = world ? world->proxies().mesh(entity.id()) : nullptr;
+        if (!mesh)
+        {
+            return false;
+        }
+
+        out = OffsetAabb(mesh->bounds(), position);
+        return true;
+    }
+}
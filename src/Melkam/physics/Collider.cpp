@@ -1,5 +1,11 @@
 #include <Melkam/physics/Collider.hpp>
 
+#include <Melkam/core/ThreadPool.hpp>
+#include <Melkam/physics/Bounds.hpp>
+#include <Melkam/physics/CollisionMesh.hpp>
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/physics/SweepAndPrune.hpp>
+#include <Melkam/physics/SweepBatch.hpp>
 #include <Melkam/scene/Components.hpp>
 #include <Melkam/scene/Entity.hpp>
 #include <Melkam/scene/Scene.hpp>
@@ -12,36 +18,13 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace Melkam
 {
-    static std::unordered_map<EntityId, std::vector<CollisionCallback>> s_collisionCallbacks;
-    static std::unordered_map<EntityId, std::vector<AreaCallback>> s_areaEnterCallbacks;
-    static std::unordered_map<EntityId, std::vector<AreaCallback>> s_areaExitCallbacks;
-
     namespace
     {
-        struct Aabb2D
-        {
-            float minX;
-            float minY;
-            float maxX;
-            float maxY;
-        };
-
-        struct Aabb3D
-        {
-            float minX;
-            float minY;
-            float minZ;
-            float maxX;
-            float maxY;
-            float maxZ;
-        };
-
         struct SlideSettings
         {
             float epsilon = 0.001f;
@@ -51,81 +34,10 @@ namespace Melkam
 
         SlideSettings s_settings;
 
-        bool intersects(const Aabb2D &a, const Aabb2D &b)
-        {
-            return a.minX < b.maxX && a.maxX > b.minX && a.minY < b.maxY && a.maxY > b.minY;
-        }
-
-        bool intersects(const Aabb3D &a, const Aabb3D &b)
-        {
-            return a.minX < b.maxX && a.maxX > b.minX && a.minY < b.maxY && a.maxY > b.minY && a.minZ < b.maxZ && a.maxZ > b.minZ;
-        }
-
-        bool getAabb2D(const Entity &entity, const TransformComponent &transform, Aabb2D &out)
-        {
-            if (const auto *box = entity.tryGetComponent<BoxShape2DComponent>())
-            {
-                const float halfX = box->size[0] * 0.5f;
-                const float halfY = box->size[1] * 0.5f;
-                out.minX = transform.position.x - halfX;
-                out.maxX = transform.position.x + halfX;
-                out.minY = transform.position.y - halfY;
-                out.maxY = transform.position.y + halfY;
-                return true;
-            }
-
-            if (const auto *circle = entity.tryGetComponent<CircleShape2DComponent>())
-            {
-                const float r = circle->radius;
-                out.minX = transform.position.x - r;
-                out.maxX = transform.position.x + r;
-                out.minY = transform.position.y - r;
-                out.maxY = transform.position.y + r;
-                return true;
-            }
-
-            return false;
-        }
-
-        bool getAabb3D(const Entity &entity, const TransformComponent &transform, Aabb3D &out)
-        {
-            if (const auto *box = entity.tryGetComponent<BoxShape3DComponent>())
-            {
-                const float halfX = box->size[0] * 0.5f;
-                const float halfY = box->size[1] * 0.5f;
-                const float halfZ = box->size[2] * 0.5f;
-                out.minX = transform.position.x - halfX;
-                out.maxX = transform.position.x + halfX;
-                out.minY = transform.position.y - halfY;
-                out.maxY = transform.position.y + halfY;
-                out.minZ = transform.position.z - halfZ;
-                out.maxZ = transform.position.z + halfZ;
-                return true;
-            }
-
-            if (const auto *sphere = entity.tryGetComponent<SphereShape3DComponent>())
-            {
-                const float r = sphere->radius;
-                out.minX = transform.position.x - r;
-                out.maxX = transform.position.x + r;
-                out.minY = transform.position.y - r;
-                out.maxY = transform.position.y + r;
-                out.minZ = transform.position.z - r;
-                out.maxZ = transform.position.z + r;
-                return true;
-            }
-
-            return false;
-        }
-
-        bool shouldCollide(const CollisionLayerComponent *a, const CollisionLayerComponent *b)
-        {
-            const std::uint32_t aLayer = a ? a->layer : 1u;
-            const std::uint32_t aMask = a ? a->mask : 0xFFFFFFFFu;
-            const std::uint32_t bLayer = b ? b->layer : 1u;
-            const std::uint32_t bMask = b ? b->mask : 0xFFFFFFFFu;
-            return (aMask & bLayer) != 0u && (bMask & aLayer) != 0u;
-        }
+        // Per-thread candidate scratch for the movers, reused across calls.
+        thread_local SweepCandidates2D t_candidates2D;
+        thread_local SweepCandidates3D t_candidates3D;
+        thread_local std::vector<MeshCandidate> t_meshCandidates;
 
         void clearContactState(ColliderComponent &collider)
         {
@@ -157,539 +69,607 @@ namespace Melkam
             }
         }
 
-        bool isTriggerLike(const Entity &entity, const ColliderComponent *collider)
+        // Queued; the move function dispatches once it is done.
+        void emitCollision(PhysicsWorld &world, EntityId selfId, EntityId otherId, float nx, float ny, float nz, float travel)
         {
-            if (!collider)
-            {
-                return false;
-            }
-
-            if (collider->isTrigger)
-            {
-                return true;
-            }
-
-            if (collider->is2D)
-            {
-                return entity.tryGetComponent<Area2DComponent>() != nullptr;
-            }
-
-            return entity.tryGetComponent<Area3DComponent>() != nullptr;
+            const float normal[3] = {nx, ny, nz};
+            world.events().recordCollision(selfId, otherId, normal, travel);
         }
 
-        void emitCollision(Scene *scene, EntityId selfId, EntityId otherId, float nx, float ny, float nz, float travel)
+        // Concave meshes are swept by their triangles, everything else by its bounds.
+        void pushCandidate(const PhysicsWorld &world, SweepCandidates3D &boxes, std::vector<MeshCandidate> &meshes, EntityId id,
+                           const Aabb3D &box)
         {
-            if (!scene || !scene->isValid(selfId) || !scene->isValid(otherId))
-            {
-                return;
-            }
-
-            auto it = s_collisionCallbacks.find(selfId);
-            if (it == s_collisionCallbacks.end())
+            if (const MeshShape *shape = world.proxies().meshShape(id))
             {
+                meshes.push_back({id, shape->mesh, {shape->origin[0], shape->origin[1], shape->origin[2]}});
                 return;
             }
-
-            CollisionInfo info{};
-            info.hit = true;
-            info.collider = otherId;
-            info.normal[0] = nx;
-            info.normal[1] = ny;
-            info.normal[2] = nz;
-            info.travel = travel;
-
-            Entity self(scene, selfId);
-            Entity other(scene, otherId);
-            for (const auto &callback : it->second)
-            {
-                if (callback)
-                {
-                    callback(self, other, info);
-                }
-            }
+            boxes.push(id, box);
         }
 
-        void emitArea(Scene *scene, const std::unordered_map<EntityId, std::vector<AreaCallback>> &callbacks,
-                      EntityId areaId, EntityId bodyId)
+        // The MoveAndSlide2D loop. query(box, layer, mask, func) feeds broadphase candidates and
+        // emit(other, nx, ny, travel) reports each hit; refreshing the proxy is left to the caller.
+        template <typename Query, typename Emit>
+        bool slide2D(Scene &scene, const PhysicsWorld &world, Entity &entity, TransformComponent &transform, Velocity2DComponent &velocity,
+                     ColliderComponent &collider, float dt, Query &&query, Emit &&emit)
         {
-            if (!scene || !scene->isValid(areaId) || !scene->isValid(bodyId))
-            {
-                return;
-            }
+            clearContactState(collider);
 
-            auto it = callbacks.find(areaId);
-            if (it == callbacks.end())
-            {
-                return;
-            }
+            const auto *moverLayers = entity.tryGetComponent<CollisionLayerComponent>();
+            const std::uint32_t moverLayer = LayerBits(moverLayers);
+            const std::uint32_t moverMask = MaskBits(moverLayers);
+            bool moved = false;
+            float remaining = 1.0f;
+            float vx = velocity.velocity[0];
+            float vy = velocity.velocity[1];
 
-            Entity area(scene, areaId);
-            Entity body(scene, bodyId);
-            for (const auto &callback : it->second)
+            for (int iter = 0; iter < s_settings.maxSlides; ++iter)
             {
-                if (callback)
+                const float dx = vx * dt * remaining;
+                const float dy = vy * dt * remaining;
+                if (std::abs(dx) <= s_settings.epsilon && std::abs(dy) <= s_settings.epsilon)
                 {
-                    callback(area, body);
+                    break;
                 }
-            }
-        }
 
-        bool overlapNormal2D(const Aabb2D &a, const Aabb2D &b, float &outNx, float &outNy)
-        {
-            if (!intersects(a, b))
-            {
-                return false;
-            }
+                Aabb2D moverBox;
+                if (!ComputeAabb2D(entity, transform, moverBox))
+                {
+                    return false;
+                }
 
-            const float overlapX1 = b.maxX - a.minX;
-            const float overlapX2 = a.maxX - b.minX;
-            const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
+                auto &candidates = t_candidates2D;
+                candidates.clear();
+                query(SweptAabb(moverBox, dx, dy), moverLayer, moverMask, [&](EntityId otherId, const Aabb2D &otherBox)
+                {
+                    if (otherId != entity.id() && scene.isValid(otherId) && !world.isTrigger(otherId))
+                    {
+                        candidates.push(otherId, otherBox);
+                    }
+                });
 
-            const float overlapY1 = b.maxY - a.minY;
-            const float overlapY2 = a.maxY - b.minY;
-            const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
+                const SweepHit sweep = SweepAabbBatch(moverBox, dx, dy, candidates);
+                const bool hit = sweep.hit;
+                const float bestTime = sweep.time;
+                float hitNx = sweep.normal[0];
+                float hitNy = sweep.normal[1];
+                const Aabb2D hitBox = hit ? candidates.box(sweep.index) : Aabb2D{};
+                const EntityId hitEntity = hit ? candidates.ids[sweep.index] : InvalidEntity;
 
-            if (std::abs(resolveX) < std::abs(resolveY))
-            {
-                outNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
-                outNy = 0.0f;
-            }
-            else
-            {
-                outNx = 0.0f;
-                outNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
-            }
-            return true;
-        }
+                if (!hit)
+                {
+                    transform.position.x += dx;
+                    transform.position.y += dy;
+                    moved = true;
+                    break;
+                }
 
-        bool overlapNormal3D(const Aabb3D &a, const Aabb3D &b, float &outNx, float &outNy, float &outNz)
-        {
-            if (!intersects(a, b))
-            {
-                return false;
-            }
+                transform.position.x += dx * bestTime;
+                transform.position.y += dy * bestTime;
 
-            const float overlapX1 = b.maxX - a.minX;
-            const float overlapX2 = a.maxX - b.minX;
-            const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
+                if (bestTime > 0.0f)
+                {
+                    transform.position.x += hitNx * s_settings.epsilon;
+                    transform.position.y += hitNy * s_settings.epsilon;
+                }
+                else
+                {
+                    Aabb2D moverBox;
+                    if (ComputeAabb2D(entity, transform, moverBox) && Intersects(moverBox, hitBox))
+                    {
+                        const float overlap1 = hitBox.maxX - moverBox.minX;
+                        const float overlap2 = moverBox.maxX - hitBox.minX;
+                        const float resolveX = (overlap1 < overlap2) ? -overlap1 : overlap2;
 
-            const float overlapY1 = b.maxY - a.minY;
-            const float overlapY2 = a.maxY - b.minY;
-            const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
+                        const float overlapY1 = hitBox.maxY - moverBox.minY;
+                        const float overlapY2 = moverBox.maxY - hitBox.minY;
+                        const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
 
-            const float overlapZ1 = b.maxZ - a.minZ;
-            const float overlapZ2 = a.maxZ - b.minZ;
-            const float resolveZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
+                        if (std::abs(resolveX) < std::abs(resolveY))
+                        {
+                            transform.position.x += resolveX;
+                            hitNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
+                            hitNy = 0.0f;
+                        }
+                        else
+                        {
+                            transform.position.y += resolveY;
+                            hitNx = 0.0f;
+                            hitNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
+                        }
+                    }
+                }
+                moved = true;
 
-            float absX = std::abs(resolveX);
-            float absY = std::abs(resolveY);
-            float absZ = std::abs(resolveZ);
+                updateContactState(collider, hitNx, hitNy, 0.0f, true);
 
-            if (absX <= absY && absX <= absZ)
-            {
-                outNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
-                outNy = 0.0f;
-                outNz = 0.0f;
-            }
-            else if (absY <= absX && absY <= absZ)
-            {
-                outNx = 0.0f;
-                outNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
-                outNz = 0.0f;
-            }
-            else
-            {
-                outNx = 0.0f;
-                outNy = 0.0f;
-                outNz = (resolveZ < 0.0f) ? -1.0f : 1.0f;
+                if (hitEntity != InvalidEntity)
+                {
+                    const float travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime));
+                    emit(hitEntity, hitNx, hitNy, travel);
+                }
+
+                const float dot = vx * hitNx + vy * hitNy;
+                vx = vx - hitNx * dot;
+                vy = vy - hitNy * dot;
+                remaining *= (1.0f - bestTime);
+
+                if (remaining <= s_settings.epsilon)
+                {
+                    break;
+                }
             }
-            return true;
+
+            velocity.velocity[0] = vx;
+            velocity.velocity[1] = vy;
+            return moved;
         }
 
-        bool sweepAabb2D(const Aabb2D &mover, const Aabb2D &target, float dx, float dy, float &outTime, float &outNx, float &outNy)
+        // The MoveAndSlide3D loop. query(box, layer, mask, func) feeds broadphase candidates and
+        // emit(other, nx, ny, nz, travel) reports each hit; refreshing the proxy is left to the caller.
+        template <typename Query, typename Emit>
+        bool slide3D(Scene &scene, const PhysicsWorld &world, Entity &entity, TransformComponent &transform, Velocity3DComponent &velocity,
+                     ColliderComponent &collider, float dt, Query &&query, Emit &&emit)
         {
-            const float inf = std::numeric_limits<float>::infinity();
-            if (dx == 0.0f && dy == 0.0f)
-            {
-                return false;
-            }
+            clearContactState(collider);
+
+            const auto *moverLayers = entity.tryGetComponent<CollisionLayerComponent>();
+            const std::uint32_t moverLayer = LayerBits(moverLayers);
+            const std::uint32_t moverMask = MaskBits(moverLayers);
+            bool moved = false;
+            float remaining = 1.0f;
+            float vx = velocity.velocity[0];
+            float vy = velocity.velocity[1];
+            float vz = velocity.velocity[2];
+
+            for (int iter = 0; iter < s_settings.maxSlides; ++iter)
+            {
+                const float dx = vx * dt * remaining;
+                const float dy = vy * dt * remaining;
+                const float dz = vz * dt * remaining;
+                if (std::abs(dx) <= s_settings.epsilon && std::abs(dy) <= s_settings.epsilon && std::abs(dz) <= s_settings.epsilon)
+                {
+                    break;
+                }
 
-            if (dx == 0.0f && (mover.maxX <= target.minX || mover.minX >= target.maxX))
-            {
-                return false;
-            }
+                Aabb3D moverBox;
+                if (!ComputeAabb3D(entity, transform, moverBox))
+                {
+                    return false;
+                }
 
-            if (dy == 0.0f && (mover.maxY <= target.minY || mover.minY >= target.maxY))
-            {
-                return false;
-            }
+                auto &candidates = t_candidates3D;
+                auto &meshes = t_meshCandidates;
+                candidates.clear();
+                meshes.clear();
+                query(SweptAabb(moverBox, dx, dy, dz), moverLayer, moverMask, [&](EntityId otherId, const Aabb3D &otherBox)
+                {
+                    if (otherId != entity.id() && scene.isValid(otherId) && !world.isTrigger(otherId))
+                    {
+                        pushCandidate(world, candidates, meshes, otherId, otherBox);
+                    }
+                });
+
+                SweepHit sweep = SweepAabbBatch(moverBox, dx, dy, dz, candidates);
+                EntityId hitEntity = sweep.hit ? candidates.ids[sweep.index] : InvalidEntity;
+                const float motion[3] = {dx, dy, dz};
+                float meshDepth = 0.0f;
+                const bool meshHit = !meshes.empty() && SweepMeshCandidates(moverBox, motion, meshes, sweep, hitEntity, meshDepth);
+                const bool hit = sweep.hit;
+                const float bestTime = sweep.time;
+                float hitNx = sweep.normal[0];
+                float hitNy = sweep.normal[1];
+                float hitNz = sweep.normal[2];
+                const Aabb3D hitBox = hit && !meshHit ? candidates.box(sweep.index) : Aabb3D{};
+
+                if (!hit)
+                {
+                    transform.position.x += dx;
+                    transform.position.y += dy;
+                    transform.position.z += dz;
+                    moved = true;
+                    break;
+                }
 
-            if (overlapNormal2D(mover, target, outNx, outNy))
-            {
-                outTime = 0.0f;
-                return true;
-            }
+                transform.position.x += dx * bestTime;
+                transform.position.y += dy * bestTime;
+                transform.position.z += dz * bestTime;
 
-            float xInvEntry;
-            float xInvExit;
-            float yInvEntry;
-            float yInvExit;
+                if (bestTime > 0.0f)
+                {
+                    transform.position.x += hitNx * s_settings.epsilon;
+                    transform.position.y += hitNy * s_settings.epsilon;
+                    transform.position.z += hitNz * s_settings.epsilon;
+                }
+                else if (meshHit)
+                {
+                    // Triangle normals need not be axis-aligned; push out along the sweep's.
+                    if (meshDepth > 0.0f)
+                    {
+                        transform.position.x += hitNx * (meshDepth + s_settings.epsilon);
+                        transform.position.y += hitNy * (meshDepth + s_settings.epsilon);
+                        transform.position.z += hitNz * (meshDepth + s_settings.epsilon);
+                    }
+                }
+                else
+                {
+                    Aabb3D moverBox;
+                    if (ComputeAabb3D(entity, transform, moverBox) && Intersects(moverBox, hitBox))
+                    {
+                        const float overlapX1 = hitBox.maxX - moverBox.minX;
+                        const float overlapX2 = moverBox.maxX - hitBox.minX;
+                        const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
 
-            if (dx > 0.0f)
-            {
-                xInvEntry = target.minX - mover.maxX;
-                xInvExit = target.maxX - mover.minX;
-            }
-            else
-            {
-                xInvEntry = target.maxX - mover.minX;
-                xInvExit = target.minX - mover.maxX;
-            }
+                        const float overlapY1 = hitBox.maxY - moverBox.minY;
+                        const float overlapY2 = moverBox.maxY - hitBox.minY;
+                        const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
 
-            if (dy > 0.0f)
-            {
-                yInvEntry = target.minY - mover.maxY;
-                yInvExit = target.maxY - mover.minY;
-            }
-            else
-            {
-                yInvEntry = target.maxY - mover.minY;
-                yInvExit = target.minY - mover.maxY;
-            }
+                        const float overlapZ1 = hitBox.maxZ - moverBox.minZ;
+                        const float overlapZ2 = moverBox.maxZ - hitBox.minZ;
+                        const float resolveZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
+
+                        float absX = std::abs(resolveX);
+                        float absY = std::abs(resolveY);
+                        float absZ = std::abs(resolveZ);
 
-            const float xEntry = (dx == 0.0f) ? -inf : xInvEntry / dx;
-            const float xExit = (dx == 0.0f) ? inf : xInvExit / dx;
-            const float yEntry = (dy == 0.0f) ? -inf : yInvEntry / dy;
-            const float yExit = (dy == 0.0f) ? inf : yInvExit / dy;
+                        if (absX <= absY && absX <= absZ)
+                        {
+                            transform.position.x += resolveX;
+                            hitNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
+                            hitNy = 0.0f;
+                            hitNz = 0.0f;
+                        }
+                        else if (absY <= absX && absY <= absZ)
+                        {
+                            transform.position.y += resolveY;
+                            hitNx = 0.0f;
+                            hitNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
+                            hitNz = 0.0f;
+                        }
+                        else
+                        {
+                            transform.position.z += resolveZ;
+                            hitNx = 0.0f;
+                            hitNy = 0.0f;
+                            hitNz = (resolveZ < 0.0f) ? -1.0f : 1.0f;
+                        }
+                    }
+                }
+                moved = true;
 
-            const float entryTime = std::max(xEntry, yEntry);
-            const float exitTime = std::min(xExit, yExit);
+                updateContactState(collider, hitNx, hitNy, hitNz, false);
 
-            if (entryTime > exitTime || entryTime > 1.0f || entryTime < 0.0f)
-            {
-                return false;
-            }
+                if (hitEntity != InvalidEntity)
+                {
+                    const float travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime) + (dz * bestTime) * (dz * bestTime));
+                    emit(hitEntity, hitNx, hitNy, hitNz, travel);
+                }
 
-            if (xEntry > yEntry)
-            {
-                outNx = (dx > 0.0f) ? -1.0f : 1.0f;
-                outNy = 0.0f;
-            }
-            else
-            {
-                outNx = 0.0f;
-                outNy = (dy > 0.0f) ? -1.0f : 1.0f;
+                const float dot = vx * hitNx + vy * hitNy + vz * hitNz;
+                vx = vx - hitNx * dot;
+                vy = vy - hitNy * dot;
+                vz = vz - hitNz * dot;
+                remaining *= (1.0f - bestTime);
+
+                if (remaining <= s_settings.epsilon)
+                {
+                    break;
+                }
             }
 
-            outTime = entryTime;
-            return true;
+            velocity.velocity[0] = vx;
+            velocity.velocity[1] = vy;
+            velocity.velocity[2] = vz;
+            return moved;
         }
 
-        bool sweepAabb3D(const Aabb3D &mover, const Aabb3D &target, float dx, float dy, float dz, float &outTime, float &outNx, float &outNy, float &outNz)
+        template <typename Velocity>
+        struct SlideBody
         {
-            const float inf = std::numeric_limits<float>::infinity();
-            if (dx == 0.0f && dy == 0.0f && dz == 0.0f)
-            {
-                return false;
-            }
+            Entity entity;
+            TransformComponent *transform;
+            Velocity *velocity;
+            ColliderComponent *collider;
+            std::size_t hitCount = 0;
+            bool moved = false;
+        };
 
-            if (dx == 0.0f && (mover.maxX <= target.minX || mover.minX >= target.maxX))
-            {
-                return false;
-            }
+        struct SlideHit
+        {
+            EntityId other;
+            float normal[3];
+            float travel;
+        };
 
-            if (dy == 0.0f && (mover.maxY <= target.minY || mover.minY >= target.maxY))
+        // Runs step(i) for i in [0, count) on the scene's thread pool. Fixed chunks, and every
+        // step only writes its own body, so the thread count cannot change the result.
+        template <typename Step>
+        void forEachBody(Scene &scene, std::size_t count, Step &&step)
+        {
+            constexpr std::size_t ChunkSize = 64;
+            ThreadPool *pool = scene.threadPool();
+            if (!pool || pool->workerCount() == 0 || count <= ChunkSize)
             {
-                return false;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    step(i);
+                }
+                return;
             }
 
-            if (dz == 0.0f && (mover.maxZ <= target.minZ || mover.minZ >= target.maxZ))
-            {
-                return false;
-            }
+            pool->parallelFor(count, ChunkSize,
+                              [&step](std::size_t begin, std::size_t end)
+                              {
+                                  for (std::size_t i = begin; i < end; ++i)
+                                  {
+                                      step(i);
+                                  }
+                              });
+        }
 
-            if (overlapNormal3D(mover, target, outNx, outNy, outNz))
+        // Moved bodies' proxies first, so callbacks see the new positions, then hits in body order,
+        // dispatched in one pass unless delivery is deferred.
+        template <typename Velocity>
+        void finishBodies(Scene &scene, PhysicsWorld &world, const std::vector<SlideBody<Velocity>> &bodies,
+                          const std::vector<SlideHit> &hits, std::size_t hitsPerBody, bool is2D, SignalDelivery delivery)
+        {
+            for (const auto &body : bodies)
             {
-                outTime = 0.0f;
-                return true;
+                if (body.moved && body.collider)
+                {
+                    world.refresh(body.entity);
+                }
             }
 
-            float xInvEntry;
-            float xInvExit;
-            float yInvEntry;
-            float yInvExit;
-            float zInvEntry;
-            float zInvExit;
-
-            if (dx > 0.0f)
+            for (std::size_t i = 0; i < bodies.size(); ++i)
             {
-                xInvEntry = target.minX - mover.maxX;
-                xInvExit = target.maxX - mover.minX;
+                const EntityId id = bodies[i].entity.id();
+                for (std::size_t h = 0; h < bodies[i].hitCount; ++h)
+                {
+                    const SlideHit &hit = hits[i * hitsPerBody + h];
+                    const float nz = is2D ? 0.0f : -hit.normal[2];
+                    emitCollision(world, id, hit.other, hit.normal[0], hit.normal[1], hit.normal[2], hit.travel);
+                    emitCollision(world, hit.other, id, -hit.normal[0], -hit.normal[1], nz, hit.travel);
+                }
             }
-            else
+            if (delivery == SignalDelivery::Immediate)
             {
-                xInvEntry = target.maxX - mover.minX;
-                xInvExit = target.minX - mover.maxX;
+                world.events().dispatch(scene);
             }
+        }
 
-            if (dy > 0.0f)
-            {
-                yInvEntry = target.minY - mover.maxY;
-                yInvExit = target.maxY - mover.minY;
-            }
-            else
-            {
-                yInvEntry = target.maxY - mover.minY;
-                yInvExit = target.minY - mover.maxY;
-            }
+        void slideBodies2D(Scene &scene, PhysicsWorld &world, std::vector<SlideBody<Velocity2DComponent>> &bodies, float dt,
+                           SignalDelivery delivery)
+        {
+            const StaticBvh2D &snapshot = world.snapshot2D();
+            const StaticBvh2D &statics = world.statics2D();
+            const std::size_t hitsPerBody = static_cast<std::size_t>(s_settings.maxSlides);
+            std::vector<SlideHit> hits(bodies.size() * hitsPerBody);
 
-            if (dz > 0.0f)
-            {
-                zInvEntry = target.minZ - mover.maxZ;
-                zInvExit = target.maxZ - mover.minZ;
-            }
-            else
-            {
-                zInvEntry = target.maxZ - mover.minZ;
-                zInvExit = target.minZ - mover.maxZ;
-            }
+            forEachBody(scene, bodies.size(),
+                        [&](std::size_t i)
+                        {
+                            auto &body = bodies[i];
+                            SlideHit *out = hits.data() + i * hitsPerBody;
+                            // Bare movers have no collider to keep contact state in.
+                            ColliderComponent bare;
+                            body.moved = slide2D(scene, world, body.entity, *body.transform, *body.velocity,
+                                                 body.collider ? *body.collider : bare, dt,
+                                                 [&](const Aabb2D &box, std::uint32_t layer, std::uint32_t mask, auto &&func)
+                                                 {
+                                                     for (const StaticBvh2D *bvh : {&snapshot, &statics})
+                                                     {
+                                                         bvh->query(box, layer, mask, [&](std::uint32_t index)
+                                                         {
+                                                             const auto &item = bvh->item(index);
+                                                             func(item.id, item.box);
+                                                         });
+                                                     }
+                                                 },
+                                                 [&](EntityId other, float nx, float ny, float travel)
+                                                 {
+                                                     out[body.hitCount++] = {other, {nx, ny, 0.0f}, travel};
+                                                 });
+                        });
+
+            finishBodies(scene, world, bodies, hits, hitsPerBody, true, delivery);
+        }
 
-            const float xEntry = (dx == 0.0f) ? -inf : xInvEntry / dx;
-            const float xExit = (dx == 0.0f) ? inf : xInvExit / dx;
-            const float yEntry = (dy == 0.0f) ? -inf : yInvEntry / dy;
-            const float yExit = (dy == 0.0f) ? inf : yInvExit / dy;
-            const float zEntry = (dz == 0.0f) ? -inf : zInvEntry / dz;
-            const float zExit = (dz == 0.0f) ? inf : zInvExit / dz;
+        void slideBodies3D(Scene &scene, PhysicsWorld &world, std::vector<SlideBody<Velocity3DComponent>> &bodies, float dt,
+                           SignalDelivery delivery)
+        {
+            // The tree's queries are const, and no proxy is refreshed until every body has moved, so
+            // it serves as the snapshot directly.
+            const std::size_t hitsPerBody = static_cast<std::size_t>(s_settings.maxSlides);
+            std::vector<SlideHit> hits(bodies.size() * hitsPerBody);
 
-            const float entryTime = std::max(xEntry, std::max(yEntry, zEntry));
-            const float exitTime = std::min(xExit, std::min(yExit, zExit));
+            forEachBody(scene, bodies.size(),
+                        [&](std::size_t i)
+                        {
+                            auto &body = bodies[i];
+                            SlideHit *out = hits.data() + i * hitsPerBody;
+                            body.moved = slide3D(scene, world, body.entity, *body.transform, *body.velocity, *body.collider, dt,
+                                                 [&world](const Aabb3D &box, std::uint32_t layer, std::uint32_t mask, auto &&func)
+                                                 {
+                                                     world.query3D(box, layer, mask, func);
+                                                 },
+                                                 [&](EntityId other, float nx, float ny, float nz, float travel)
+                                                 {
+                                                     out[body.hitCount++] = {other, {nx, ny, nz}, travel};
+                                                 });
+                        });
+
+            finishBodies(scene, world, bodies, hits, hitsPerBody, false, delivery);
+        }
 
-            if (entryTime > exitTime || entryTime > 1.0f || entryTime < 0.0f)
+        class RigidBodySystem : public System
+        {
+        public:
+            RigidBodySystem()
             {
-                return false;
+                DeclarePhysicsWorldAccess(declareAccess());
+                declareAccess().write<TransformComponent, PreviousTransformComponent, RigidBodyComponent, RigidBody2DComponent,
+                                      RigidBody3DComponent>();
             }
 
-            if (xEntry >= yEntry && xEntry >= zEntry)
-            {
-                outNx = (dx > 0.0f) ? -1.0f : 1.0f;
-                outNy = 0.0f;
-                outNz = 0.0f;
-            }
-            else if (yEntry >= xEntry && yEntry >= zEntry)
-            {
-                outNx = 0.0f;
-                outNy = (dy > 0.0f) ? -1.0f : 1.0f;
-                outNz = 0.0f;
-            }
-            else
+            void onUpdate(Scene &scene, float dt) override
             {
-                outNx = 0.0f;
-                outNy = 0.0f;
-                outNz = (dz > 0.0f) ? -1.0f : 1.0f;
+                auto &world = PhysicsWorld::get(scene);
+                world.syncIfStale(scene);
+                const int steps = world.accumulate(scene, dt);
+                for (int i = 0; i < steps; ++i)
+                {
+                    world.rigidBodies2D().step(scene, world, world.fixedTimestep());
+                    world.rigidBodies3D().step(scene, world, world.fixedTimestep());
+                }
             }
-
-            outTime = entryTime;
-            return true;
-        }
+        };
 
         class AreaSignalSystem : public System
         {
         public:
-            void onUpdate(Scene &scene, float dt) override
+            AreaSignalSystem()
             {
-                (void)dt;
-                update2D(scene);
-                update3D(scene);
+                DeclarePhysicsWorldAccess(declareAccess());
             }
 
-        private:
-            void update2D(Scene &scene)
+            void onUpdate(Scene &scene, float dt) override
             {
-                std::unordered_set<EntityId> activeAreas;
-                auto bodies = scene.view<TransformComponent, ColliderComponent>();
-
-                for (auto &area : scene.view<TransformComponent, ColliderComponent, Area2DComponent>())
+                (void)dt;
+                const auto areas2D = scene.view<Area2DComponent>();
+                const auto areas3D = scene.view<Area3DComponent>();
+                const bool has2D = areas2D.begin() != areas2D.end();
+                const bool has3D = areas3D.begin() != areas3D.end();
+
+                // Without areas there is nothing to report; dropping the proxies also drops the
+                // pairs, like the per-area state used to be dropped with its area.
+                if (!has2D)
                 {
-                    auto *areaTransform = area.tryGetComponent<TransformComponent>();
-                    auto *areaCollider = area.tryGetComponent<ColliderComponent>();
-                    if (!areaTransform || !areaCollider || !areaCollider->is2D)
-                    {
-                        continue;
-                    }
-
-                    Aabb2D areaBox;
-                    if (!getAabb2D(area, *areaTransform, areaBox))
-                    {
-                        continue;
-                    }
-
-                    activeAreas.insert(area.id());
-                    auto &previous = m_prev2D[area.id()];
-                    std::unordered_set<EntityId> current;
-
-                    for (auto &body : bodies)
-                    {
-                        if (body.id() == area.id())
-                        {
-                            continue;
-                        }
-
-                        auto *bodyCollider = body.tryGetComponent<ColliderComponent>();
-                        auto *bodyTransform = body.tryGetComponent<TransformComponent>();
-                        if (!bodyCollider || !bodyTransform || !bodyCollider->is2D)
-                        {
-                            continue;
-                        }
-
-                        if (bodyCollider->isTrigger || body.tryGetComponent<Area2DComponent>())
-                        {
-                            continue;
-                        }
-
-                        if (!shouldCollide(area.tryGetComponent<CollisionLayerComponent>(), body.tryGetComponent<CollisionLayerComponent>()))
-                        {
-                            continue;
-                        }
-
-                        Aabb2D bodyBox;
-                        if (!getAabb2D(body, *bodyTransform, bodyBox))
-                        {
-                            continue;
-                        }
-
-                        if (!intersects(areaBox, bodyBox))
-                        {
-                            continue;
-                        }
-
-                        current.insert(body.id());
-                        if (previous.find(body.id()) == previous.end())
-                        {
-                            emitArea(&scene, s_areaEnterCallbacks, area.id(), body.id());
-                        }
-                    }
-
-                    for (EntityId prevBody : previous)
-                    {
-                        if (current.find(prevBody) == current.end())
-                        {
-                            emitArea(&scene, s_areaExitCallbacks, area.id(), prevBody);
-                        }
-                    }
-
-                    previous = std::move(current);
+                    m_sweep2D.clear();
+                    m_pairs2D.clear();
                 }
-
-                for (auto it = m_prev2D.begin(); it != m_prev2D.end();)
+                if (!has3D)
                 {
-                    if (activeAreas.find(it->first) == activeAreas.end())
-                    {
-                        it = m_prev2D.erase(it);
-                    }
-                    else
-                    {
-                        ++it;
-                    }
+                    m_sweep3D.clear();
+                    m_pairs3D.clear();
                 }
-            }
-
-            void update3D(Scene &scene)
-            {
-                std::unordered_set<EntityId> activeAreas;
-                auto bodies = scene.view<TransformComponent, ColliderComponent>();
-
-                for (auto &area : scene.view<TransformComponent, ColliderComponent, Area3DComponent>())
+                if (!has2D && !has3D)
                 {
-                    auto *areaTransform = area.tryGetComponent<TransformComponent>();
-                    auto *areaCollider = area.tryGetComponent<ColliderComponent>();
-                    if (!areaTransform || !areaCollider || areaCollider->is2D)
-                    {
-                        continue;
-                    }
-
-                    Aabb3D areaBox;
-                    if (!getAabb3D(area, *areaTransform, areaBox))
-                    {
-                        continue;
-                    }
-
-                    activeAreas.insert(area.id());
-                    auto &previous = m_prev3D[area.id()];
-                    std::unordered_set<EntityId> current;
-
-                    for (auto &body : bodies)
-                    {
-                        if (body.id() == area.id())
-                        {
-                            continue;
-                        }
-
-                        auto *bodyCollider = body.tryGetComponent<ColliderComponent>();
-                        auto *bodyTransform = body.tryGetComponent<TransformComponent>();
-                        if (!bodyCollider || !bodyTransform || bodyCollider->is2D)
-                        {
-                            continue;
-                        }
-
-                        if (bodyCollider->isTrigger || body.tryGetComponent<Area3DComponent>())
-                        {
-                            continue;
-                        }
-
-                        if (!shouldCollide(area.tryGetComponent<CollisionLayerComponent>(), body.tryGetComponent<CollisionLayerComponent>()))
-                        {
-                            continue;
-                        }
+                    return;
+                }
 
-                        Aabb3D bodyBox;
-                        if (!getAabb3D(body, *bodyTransform, bodyBox))
-                        {
-                            continue;
-                        }
+                // PhysicsSignalSystem fires what this queues.
+                syncProxies(scene, has2D, has3D);
+                auto &events = PhysicsWorld::get(scene).events();
+                if (has2D)
+                {
+                    emitChanges(events, m_sweep2D, m_pairs2D);
+                }
+                if (has3D)
+                {
+                    emitChanges(events, m_sweep3D, m_pairs3D);
+                }
+            }
 
-                        if (!intersects(areaBox, bodyBox))
-                        {
-                            continue;
-                        }
+        private:
+            // Areas are sensors; bodies are solid colliders that are not areas themselves.
+            void syncProxies(Scene &scene, bool sync2D, bool sync3D)
+            {
+                auto &world = PhysicsWorld::get(scene);
+                world.syncIfStale(scene);
 
-                        current.insert(body.id());
-                        if (previous.find(body.id()) == previous.end())
-                        {
-                            emitArea(&scene, s_areaEnterCallbacks, area.id(), body.id());
-                        }
+                m_sweep2D.beginSync();
+                m_sweep3D.beginSync();
+                for (const ColliderProxy &proxy : world.proxies().proxies())
+                {
+                    if ((!proxy.isArea() && proxy.isTrigger()) || proxy.isBare())
+                    {
+                        continue;
                     }
 
-                    for (EntityId prevBody : previous)
+                    if (proxy.is2D())
                     {
-                        if (current.find(prevBody) == current.end())
+                        if (sync2D)
                         {
-                            emitArea(&scene, s_areaExitCallbacks, area.id(), prevBody);
+                            m_sweep2D.update(proxy.id, proxy.bounds2D(), proxy.layer, proxy.mask, proxy.isArea());
                         }
                     }
-
-                    previous = std::move(current);
+                    else if (sync3D)
+                    {
+                        m_sweep3D.update(proxy.id, proxy.bounds, proxy.layer, proxy.mask, proxy.isArea());
+                    }
                 }
+                m_sweep2D.endSync();
+                m_sweep3D.endSync();
+            }
 
-                for (auto it = m_prev3D.begin(); it != m_prev3D.end();)
+            // Both pair lists are sorted, so one merge pass yields the enters and exits. Pairs of
+            // areas that are gone are dropped without an exit, as before.
+            template <typename Box>
+            void emitChanges(PhysicsEvents &events, SweepAndPrune<Box> &sweep, std::vector<typename SweepAndPrune<Box>::Pair> &previous)
+            {
+                const auto &current = sweep.sweep();
+                std::size_t i = 0;
+                std::size_t j = 0;
+                while (i < current.size() || j < previous.size())
                 {
-                    if (activeAreas.find(it->first) == activeAreas.end())
+                    if (j == previous.size() || (i < current.size() && current[i] < previous[j]))
+                    {
+                        events.recordAreaEntered(current[i].sensor, current[i].body);
+                        ++i;
+                    }
+                    else if (i == current.size() || previous[j] < current[i])
                     {
-                        it = m_prev3D.erase(it);
+                        if (sweep.isSensor(previous[j].sensor))
+                        {
+                            events.recordAreaExited(previous[j].sensor, previous[j].body);
+                        }
+                        ++j;
                     }
                     else
                     {
-                        ++it;
+                        ++i;
+                        ++j;
                     }
                 }
+
+                previous.assign(current.begin(), current.end());
             }
 
-            std::unordered_map<EntityId, std::unordered_set<EntityId>> m_prev2D;
-            std::unordered_map<EntityId, std::unordered_set<EntityId>> m_prev3D;
+            SweepAndPrune<Aabb2D> m_sweep2D;
+            SweepAndPrune<Aabb3D> m_sweep3D;
+            // Last sweep's overlapping (area, body) pairs, sorted.
+            std::vector<SweepAndPrune<Aabb2D>::Pair> m_pairs2D;
+            std::vector<SweepAndPrune<Aabb3D>::Pair> m_pairs3D;
+        };
+
+        // Fires the signals the physics systems queued. It declares no access, so it runs alone,
+        // and is pinned, so callbacks may touch any component, UI included.
+        class PhysicsSignalSystem : public System
+        {
+        public:
+            PhysicsSignalSystem()
+            {
+                declareAccess().pinToMainThread();
+            }
+
+            void onUpdate(Scene &scene, float dt) override
+            {
+                (void)dt;
+                PhysicsWorld::get(scene).events().dispatch(scene);
+            }
         };
 
         class Render3DSystem : public System
         {
         public:
+            Render3DSystem()
+            {
+                // No declared access: UpdateUi runs button callbacks, which may touch anything.
+                declareAccess().pinToMainThread();
+            }
+
             void onUpdate(Scene &scene, float dt) override
             {
                 (void)dt;
@@ -759,28 +739,33 @@ namespace Melkam
                 camera.fovy = 60.0f;
                 camera.projection = CAMERA_PERSPECTIVE;
 
-                for (auto &entity : scene.view<TransformComponent, CameraComponent>())
+                // Pick up this frame's movement before reading world matrices.
+                scene.updateWorldTransforms();
+
+                for (auto &entity : scene.view<WorldTransformComponent, CameraComponent>())
                 {
-                    auto *transform = entity.tryGetComponent<TransformComponent>();
+                    auto *world = entity.tryGetComponent<WorldTransformComponent>();
                     auto *cameraComponent = entity.tryGetComponent<CameraComponent>();
-                    if (!transform || !cameraComponent)
+                    if (!world || !cameraComponent)
                     {
                         continue;
                     }
 
-                    camera.position = {transform->position.x, transform->position.y, transform->position.z};
+                    const Vector3f eye = world->matrix.translation();
+                    camera.position = {eye.x, eye.y, eye.z};
                     camera.fovy = cameraComponent->fov;
                     break;
                 }
 
-                for (auto &entity : scene.view<TransformComponent, CharacterBody3DComponent>())
+                for (auto &entity : scene.view<WorldTransformComponent, CharacterBody3DComponent>())
                 {
-                    auto *transform = entity.tryGetComponent<TransformComponent>();
-                    if (!transform)
+                    auto *world = entity.tryGetComponent<WorldTransformComponent>();
+                    if (!world)
                     {
                         continue;
                     }
-                    camera.target = {transform->position.x, transform->position.y, transform->position.z};
+                    const Vector3f target = world->matrix.translation();
+                    camera.target = {target.x, target.y, target.z};
                     break;
                 }
 
@@ -799,45 +784,35 @@ namespace Melkam
 
                 BeginShaderMode(shader);
 
-                for (auto &entity : scene.view<TransformComponent, BoxShape3DComponent>())
-                {
-                    auto *transform = entity.tryGetComponent<TransformComponent>();
-                    auto *shape = entity.tryGetComponent<BoxShape3DComponent>();
-                    if (!transform || !shape)
-                    {
-                        continue;
-                    }
-
-                    Color drawColor = RAYWHITE;
-                    if (auto *render = entity.tryGetComponent<Render2DComponent>())
+                scene.view<WorldTransformComponent, BoxShape3DComponent>().each(
+                    [&](Entity entity, const WorldTransformComponent &world, const BoxShape3DComponent &shape)
                     {
-                        drawColor = {render->color[0], render->color[1], render->color[2], render->color[3]};
-                    }
-
-                    Vector3 position = {transform->position.x, transform->position.y, transform->position.z};
-                    Vector3 scale = {shape->size[0], shape->size[1], shape->size[2]};
-                    DrawModelEx(cubeModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, drawColor);
-                }
+                        Color drawColor = RAYWHITE;
+                        if (const auto *render = entity.tryGetComponent<Render2DComponent>())
+                        {
+                            drawColor = {render->color[0], render->color[1], render->color[2], render->color[3]};
+                        }
 
-                for (auto &entity : scene.view<TransformComponent, SphereShape3DComponent>())
-                {
-                    auto *transform = entity.tryGetComponent<TransformComponent>();
-                    auto *shape = entity.tryGetComponent<SphereShape3DComponent>();
-                    if (!transform || !shape)
-                    {
-                        continue;
-                    }
+                        const Vector3f origin = world.matrix.translation();
+                        Vector3 position = {origin.x, origin.y, origin.z};
+                        Vector3 scale = {shape.size[0], shape.size[1], shape.size[2]};
+                        DrawModelEx(cubeModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, drawColor);
+                    });
 
-                    Color drawColor = RAYWHITE;
-                    if (auto *render = entity.tryGetComponent<Render2DComponent>())
+                scene.view<WorldTransformComponent, SphereShape3DComponent>().each(
+                    [&](Entity entity, const WorldTransformComponent &world, const SphereShape3DComponent &shape)
                     {
-                        drawColor = {render->color[0], render->color[1], render->color[2], render->color[3]};
-                    }
+                        Color drawColor = RAYWHITE;
+                        if (const auto *render = entity.tryGetComponent<Render2DComponent>())
+                        {
+                            drawColor = {render->color[0], render->color[1], render->color[2], render->color[3]};
+                        }
 
-                    Vector3 position = {transform->position.x, transform->position.y, transform->position.z};
-                    Vector3 scale = {shape->radius, shape->radius, shape->radius};
-                    DrawModelEx(sphereModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, drawColor);
-                }
+                        const Vector3f origin = world.matrix.translation();
+                        Vector3 position = {origin.x, origin.y, origin.z};
+                        Vector3 scale = {shape.radius, shape.radius, shape.radius};
+                        DrawModelEx(sphereModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, drawColor);
+                    });
 
                 EndShaderMode();
                 DrawGrid(20, 1.0f);
@@ -851,10 +826,19 @@ namespace Melkam
 
     void RegisterColliderSystems(Scene &scene)
     {
+        scene.createSystem<RigidBodySystem>();
         scene.createSystem<AreaSignalSystem>();
+        RegisterPhysicsSignalSystem(scene);
         scene.createSystem<Render3DSystem>();
     }
 
+    void RegisterPhysicsSignalSystem(Scene &scene)
+    {
+        // Created here so systems on worker threads never race to construct it.
+        PhysicsWorld::get(scene);
+        scene.createSystem<PhysicsSignalSystem>();
+    }
+
     void SetSlideSettings(float epsilon, int maxSlides)
     {
         s_settings.epsilon = std::max(0.00001f, epsilon);
@@ -872,152 +856,25 @@ namespace Melkam
             return false;
         }
 
-        clearContactState(*collider);
-
-        const auto all = scene->view<TransformComponent, ColliderComponent>();
-        bool moved = false;
-        float remaining = 1.0f;
-        float vx = velocity->velocity[0];
-        float vy = velocity->velocity[1];
-
-        for (int iter = 0; iter < s_settings.maxSlides; ++iter)
+        auto &world = PhysicsWorld::get(*scene);
+        world.syncIfStale(*scene);
+
+        const EntityId id = entity.id();
+        const bool moved = slide2D(*scene, world, entity, *transform, *velocity, *collider, dt,
+                                   [&world](const Aabb2D &box, std::uint32_t layer, std::uint32_t mask, auto &&func)
+                                   {
+                                       world.query2D(box, layer, mask, func);
+                                   },
+                                   [&world, id](EntityId other, float nx, float ny, float travel)
+                                   {
+                                       emitCollision(world, id, other, nx, ny, 0.0f, travel);
+                                       emitCollision(world, other, id, -nx, -ny, 0.0f, travel);
+                                   });
+        if (moved)
         {
-            const float dx = vx * dt * remaining;
-            const float dy = vy * dt * remaining;
-            if (std::abs(dx) <= s_settings.epsilon && std::abs(dy) <= s_settings.epsilon)
-            {
-                break;
-            }
-
-            Aabb2D moverBox;
-            if (!getAabb2D(entity, *transform, moverBox))
-            {
-                return false;
-            }
-
-            float bestTime = 1.0f;
-            float hitNx = 0.0f;
-            float hitNy = 0.0f;
-            bool hit = false;
-            Aabb2D hitBox{};
-            EntityId hitEntity = InvalidEntity;
-
-            for (auto &other : all)
-            {
-                if (other.id() == entity.id())
-                {
-                    continue;
-                }
-
-                auto *otherCollider = other.tryGetComponent<ColliderComponent>();
-                auto *otherTransform = other.tryGetComponent<TransformComponent>();
-                if (!otherCollider || !otherTransform || !otherCollider->is2D)
-                {
-                    continue;
-                }
-
-                if (!shouldCollide(entity.tryGetComponent<CollisionLayerComponent>(), other.tryGetComponent<CollisionLayerComponent>()))
-                {
-                    continue;
-                }
-
-                if (isTriggerLike(other, otherCollider))
-                {
-                    continue;
-                }
-
-                Aabb2D otherBox;
-                if (!getAabb2D(other, *otherTransform, otherBox))
-                {
-                    continue;
-                }
-
-                float time = 0.0f;
-                float nx = 0.0f;
-                float ny = 0.0f;
-                if (!sweepAabb2D(moverBox, otherBox, dx, dy, time, nx, ny))
-                {
-                    continue;
-                }
-
-                if (time < bestTime)
-                {
-                    bestTime = time;
-                    hitNx = nx;
-                    hitNy = ny;
-                    hit = true;
-                    hitBox = otherBox;
-                    hitEntity = other.id();
-                }
-            }
-
-            if (!hit)
-            {
-                transform->position.x += dx;
-                transform->position.y += dy;
-                moved = true;
-                break;
-            }
-
-            transform->position.x += dx * bestTime;
-            transform->position.y += dy * bestTime;
-
-            if (bestTime > 0.0f)
-            {
-                transform->position.x += hitNx * s_settings.epsilon;
-                transform->position.y += hitNy * s_settings.epsilon;
-            }
-            else
-            {
-                Aabb2D moverBox;
-                if (getAabb2D(entity, *transform, moverBox) && intersects(moverBox, hitBox))
-                {
-                    const float overlap1 = hitBox.maxX - moverBox.minX;
-                    const float overlap2 = moverBox.maxX - hitBox.minX;
-                    const float resolveX = (overlap1 < overlap2) ? -overlap1 : overlap2;
-
-                    const float overlapY1 = hitBox.maxY - moverBox.minY;
-                    const float overlapY2 = moverBox.maxY - hitBox.minY;
-                    const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
-
-                    if (std::abs(resolveX) < std::abs(resolveY))
-                    {
-                        transform->position.x += resolveX;
-                        hitNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
-                        hitNy = 0.0f;
-                    }
-                    else
-                    {
-                        transform->position.y += resolveY;
-                        hitNx = 0.0f;
-                        hitNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
-                    }
-                }
-            }
-            moved = true;
-
-            updateContactState(*collider, hitNx, hitNy, 0.0f, true);
-
-            if (hitEntity != InvalidEntity)
-            {
-                const float travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime));
-                emitCollision(scene, entity.id(), hitEntity, hitNx, hitNy, 0.0f, travel);
-                emitCollision(scene, hitEntity, entity.id(), -hitNx, -hitNy, 0.0f, travel);
-            }
-
-            const float dot = vx * hitNx + vy * hitNy;
-            vx = vx - hitNx * dot;
-            vy = vy - hitNy * dot;
-            remaining *= (1.0f - bestTime);
-
-            if (remaining <= s_settings.epsilon)
-            {
-                break;
-            }
+            world.refresh(entity);
         }
-
-        velocity->velocity[0] = vx;
-        velocity->velocity[1] = vy;
+        world.events().dispatch(*scene);
         return moved;
     }
 
@@ -1032,180 +889,127 @@ namespace Melkam
             return false;
         }
 
-        clearContactState(*collider);
-
-        const auto all = scene->view<TransformComponent, ColliderComponent>();
-        bool moved = false;
-        float remaining = 1.0f;
-        float vx = velocity->velocity[0];
-        float vy = velocity->velocity[1];
-        float vz = velocity->velocity[2];
-
-        for (int iter = 0; iter < s_settings.maxSlides; ++iter)
+        auto &world = PhysicsWorld::get(*scene);
+        world.syncIfStale(*scene);
+
+        const EntityId id = entity.id();
+        const bool moved = slide3D(*scene, world, entity, *transform, *velocity, *collider, dt,
+                                   [&world](const Aabb3D &box, std::uint32_t layer, std::uint32_t mask, auto &&func)
+                                   {
+                                       world.query3D(box, layer, mask, func);
+                                   },
+                                   [&world, id](EntityId other, float nx, float ny, float nz, float travel)
+                                   {
+                                       emitCollision(world, id, other, nx, ny, nz, travel);
+                                       emitCollision(world, other, id, -nx, -ny, -nz, travel);
+                                   });
+        if (moved)
         {
-            const float dx = vx * dt * remaining;
-            const float dy = vy * dt * remaining;
-            const float dz = vz * dt * remaining;
-            if (std::abs(dx) <= s_settings.epsilon && std::abs(dy) <= s_settings.epsilon && std::abs(dz) <= s_settings.epsilon)
-            {
-                break;
-            }
+            world.refresh(entity);
+        }
+        world.events().dispatch(*scene);
+        return moved;
+    }
 
-            Aabb3D moverBox;
-            if (!getAabb3D(entity, *transform, moverBox))
-            {
-                return false;
-            }
+    void MoveAndSlideCharacters2D(Scene &scene, float dt, SignalDelivery delivery)
+    {
+        if (dt <= 0.0f)
+        {
+            return;
+        }
 
-            float bestTime = 1.0f;
-            float hitNx = 0.0f;
-            float hitNy = 0.0f;
-            float hitNz = 0.0f;
-            bool hit = false;
-            Aabb3D hitBox{};
-            EntityId hitEntity = InvalidEntity;
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
 
-            for (auto &other : all)
+        std::vector<SlideBody<Velocity2DComponent>> bodies;
+        scene.view<CharacterBody2DComponent, Velocity2DComponent, TransformComponent, ColliderComponent>().each(
+            [&bodies](Entity entity, CharacterBody2DComponent &, Velocity2DComponent &velocity, TransformComponent &transform,
+                      ColliderComponent &collider)
             {
-                if (other.id() == entity.id())
+                if (collider.is2D)
                 {
-                    continue;
+                    bodies.push_back({entity, &transform, &velocity, &collider});
                 }
+            });
 
-                auto *otherCollider = other.tryGetComponent<ColliderComponent>();
-                auto *otherTransform = other.tryGetComponent<TransformComponent>();
-                if (!otherCollider || !otherTransform || otherCollider->is2D)
-                {
-                    continue;
-                }
-
-                if (!shouldCollide(entity.tryGetComponent<CollisionLayerComponent>(), other.tryGetComponent<CollisionLayerComponent>()))
-                {
-                    continue;
-                }
+        slideBodies2D(scene, world, bodies, dt, delivery);
+    }
 
-                if (isTriggerLike(other, otherCollider))
-                {
-                    continue;
-                }
+    void MoveAndSlideCharacters3D(Scene &scene, float dt, SignalDelivery delivery)
+    {
+        if (dt <= 0.0f)
+        {
+            return;
+        }
 
-                Aabb3D otherBox;
-                if (!getAabb3D(other, *otherTransform, otherBox))
-                {
-                    continue;
-                }
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
 
-                float time = 0.0f;
-                float nx = 0.0f;
-                float ny = 0.0f;
-                float nz = 0.0f;
-                if (!sweepAabb3D(moverBox, otherBox, dx, dy, dz, time, nx, ny, nz))
+        std::vector<SlideBody<Velocity3DComponent>> bodies;
+        scene.view<CharacterBody3DComponent, Velocity3DComponent, TransformComponent, ColliderComponent>().each(
+            [&bodies](Entity entity, CharacterBody3DComponent &, Velocity3DComponent &velocity, TransformComponent &transform,
+                      ColliderComponent &collider)
+            {
+                if (!collider.is2D)
                 {
-                    continue;
+                    bodies.push_back({entity, &transform, &velocity, &collider});
                 }
+            });
 
-                if (time < bestTime)
-                {
-                    bestTime = time;
-                    hitNx = nx;
-                    hitNy = ny;
-                    hitNz = nz;
-                    hit = true;
-                    hitBox = otherBox;
-                    hitEntity = other.id();
-                }
-            }
+        slideBodies3D(scene, world, bodies, dt, delivery);
+    }
 
-            if (!hit)
-            {
-                transform->position.x += dx;
-                transform->position.y += dy;
-                transform->position.z += dz;
-                moved = true;
-                break;
-            }
+    void MoveAndSlideBatch2D(Scene &scene, const std::vector<EntityId> &entities, float dt, SignalDelivery delivery)
+    {
+        if (dt <= 0.0f)
+        {
+            return;
+        }
 
-            transform->position.x += dx * bestTime;
-            transform->position.y += dy * bestTime;
-            transform->position.z += dz * bestTime;
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
 
-            if (bestTime > 0.0f)
-            {
-                transform->position.x += hitNx * s_settings.epsilon;
-                transform->position.y += hitNy * s_settings.epsilon;
-                transform->position.z += hitNz * s_settings.epsilon;
-            }
-            else
+        std::vector<SlideBody<Velocity2DComponent>> bodies;
+        bodies.reserve(entities.size());
+        for (EntityId id : entities)
+        {
+            auto *transform = scene.tryGetComponent<TransformComponent>(id);
+            auto *velocity = scene.tryGetComponent<Velocity2DComponent>(id);
+            auto *collider = scene.tryGetComponent<ColliderComponent>(id);
+            const bool slides = collider ? collider->is2D : scene.hasComponent<BoxShape2DComponent>(id);
+            if (transform && velocity && slides)
             {
-                Aabb3D moverBox;
-                if (getAabb3D(entity, *transform, moverBox) && intersects(moverBox, hitBox))
-                {
-                    const float overlapX1 = hitBox.maxX - moverBox.minX;
-                    const float overlapX2 = moverBox.maxX - hitBox.minX;
-                    const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
-
-                    const float overlapY1 = hitBox.maxY - moverBox.minY;
-                    const float overlapY2 = moverBox.maxY - hitBox.minY;
-                    const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
-
-                    const float overlapZ1 = hitBox.maxZ - moverBox.minZ;
-                    const float overlapZ2 = moverBox.maxZ - hitBox.minZ;
-                    const float resolveZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
-
-                    float absX = std::abs(resolveX);
-                    float absY = std::abs(resolveY);
-                    float absZ = std::abs(resolveZ);
-
-                    if (absX <= absY && absX <= absZ)
-                    {
-                        transform->position.x += resolveX;
-                        hitNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
-                        hitNy = 0.0f;
-                        hitNz = 0.0f;
-                    }
-                    else if (absY <= absX && absY <= absZ)
-                    {
-                        transform->position.y += resolveY;
-                        hitNx = 0.0f;
-                        hitNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
-                        hitNz = 0.0f;
-                    }
-                    else
-                    {
-                        transform->position.z += resolveZ;
-                        hitNx = 0.0f;
-                        hitNy = 0.0f;
-                        hitNz = (resolveZ < 0.0f) ? -1.0f : 1.0f;
-                    }
-                }
+                bodies.push_back({Entity(&scene, id), transform, velocity, collider});
             }
-            moved = true;
+        }
 
-            updateContactState(*collider, hitNx, hitNy, hitNz, false);
+        slideBodies2D(scene, world, bodies, dt, delivery);
+    }
 
-            if (hitEntity != InvalidEntity)
-            {
-                const float travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime) + (dz * bestTime) * (dz * bestTime));
-                emitCollision(scene, entity.id(), hitEntity, hitNx, hitNy, hitNz, travel);
-                emitCollision(scene, hitEntity, entity.id(), -hitNx, -hitNy, -hitNz, travel);
-            }
+    void MoveAndSlideBatch3D(Scene &scene, const std::vector<EntityId> &entities, float dt, SignalDelivery delivery)
+    {
+        if (dt <= 0.0f)
+        {
+            return;
+        }
 
-            const float dot = vx * hitNx + vy * hitNy + vz * hitNz;
-            vx = vx - hitNx * dot;
-            vy = vy - hitNy * dot;
-            vz = vz - hitNz * dot;
-            remaining *= (1.0f - bestTime);
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
 
-            if (remaining <= s_settings.epsilon)
+        std::vector<SlideBody<Velocity3DComponent>> bodies;
+        bodies.reserve(entities.size());
+        for (EntityId id : entities)
+        {
+            auto *transform = scene.tryGetComponent<TransformComponent>(id);
+            auto *velocity = scene.tryGetComponent<Velocity3DComponent>(id);
+            auto *collider = scene.tryGetComponent<ColliderComponent>(id);
+            if (transform && velocity && collider && !collider->is2D)
             {
-                break;
+                bodies.push_back({Entity(&scene, id), transform, velocity, collider});
             }
         }
 
-        velocity->velocity[0] = vx;
-        velocity->velocity[1] = vy;
-        velocity->velocity[2] = vz;
-        return moved;
+        slideBodies3D(scene, world, bodies, dt, delivery);
     }
 
     bool MoveAndCollide2D(Entity &entity, const float motion[2], float dt)
@@ -1236,77 +1040,39 @@ namespace Melkam
 
         const float dx = motion[0];
         const float dy = motion[1];
-        const auto all = scene->view<TransformComponent, ColliderComponent>();
+        auto &world = PhysicsWorld::get(*scene);
+        world.syncIfStale(*scene);
+
+        const auto *moverLayers = entity.tryGetComponent<CollisionLayerComponent>();
 
         Aabb2D moverBox;
-        if (!getAabb2D(entity, *transform, moverBox))
+        if (!ComputeAabb2D(entity, *transform, moverBox))
         {
             return false;
         }
 
-        float bestTime = 1.0f;
-        float hitNx = 0.0f;
-        float hitNy = 0.0f;
-        EntityId hitEntity = InvalidEntity;
-        Aabb2D hitBox{};
-
-        for (auto &other : all)
+        auto &candidates = t_candidates2D;
+        candidates.clear();
+        world.query2D(SweptAabb(moverBox, dx, dy), LayerBits(moverLayers), MaskBits(moverLayers), [&](EntityId otherId, const Aabb2D &otherBox)
         {
-            if (other.id() == entity.id())
+            if (otherId != entity.id() && scene->isValid(otherId) && !world.isTrigger(otherId))
             {
-                continue;
+                candidates.push(otherId, otherBox);
             }
+        });
 
-            auto *otherCollider = other.tryGetComponent<ColliderComponent>();
-            auto *otherTransform = other.tryGetComponent<TransformComponent>();
-            if (!otherCollider || !otherTransform || !otherCollider->is2D)
-            {
-                continue;
-            }
-
-            if (!shouldCollide(entity.tryGetComponent<CollisionLayerComponent>(), other.tryGetComponent<CollisionLayerComponent>()))
-            {
-                continue;
-            }
-
-            if (isTriggerLike(other, otherCollider))
-            {
-                continue;
-            }
-
-            if (isTriggerLike(other, otherCollider))
-            {
-                continue;
-            }
-
-            Aabb2D otherBox;
-            if (!getAabb2D(other, *otherTransform, otherBox))
-            {
-                continue;
-            }
-
-            float time = 0.0f;
-            float nx = 0.0f;
-            float ny = 0.0f;
-            if (!sweepAabb2D(moverBox, otherBox, dx, dy, time, nx, ny))
-            {
-                continue;
-            }
-
-            if (time < bestTime)
-            {
-                bestTime = time;
-                hitNx = nx;
-                hitNy = ny;
-                hitEntity = other.id();
-                hitBox = otherBox;
-            }
-        }
+        const SweepHit sweep = SweepAabbBatch(moverBox, dx, dy, candidates);
+        const float bestTime = sweep.time;
+        float hitNx = sweep.normal[0];
+        float hitNy = sweep.normal[1];
+        const EntityId hitEntity = sweep.hit ? candidates.ids[sweep.index] : InvalidEntity;
+        const Aabb2D hitBox = sweep.hit ? candidates.box(sweep.index) : Aabb2D{};
 
         if (hitEntity == InvalidEntity)
         {
             transform->position.x += dx;
             transform->position.y += dy;
+            world.refresh(entity);
             return false;
         }
 
@@ -1321,7 +1087,7 @@ namespace Melkam
         else
         {
             Aabb2D moverBox2;
-            if (getAabb2D(entity, *transform, moverBox2) && intersects(moverBox2, hitBox))
+            if (ComputeAabb2D(entity, *transform, moverBox2) && Intersects(moverBox2, hitBox))
             {
                 const float overlap1 = hitBox.maxX - moverBox2.minX;
                 const float overlap2 = moverBox2.maxX - hitBox.minX;
@@ -1347,6 +1113,7 @@ namespace Melkam
         }
 
         updateContactState(*collider, hitNx, hitNy, 0.0f, true);
+        world.refresh(entity);
 
         outInfo.hit = true;
         outInfo.collider = hitEntity;
@@ -1354,8 +1121,9 @@ namespace Melkam
         outInfo.normal[1] = collider->lastNormal[1];
         outInfo.normal[2] = collider->lastNormal[2];
         outInfo.travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime));
-        emitCollision(scene, entity.id(), hitEntity, outInfo.normal[0], outInfo.normal[1], outInfo.normal[2], outInfo.travel);
-        emitCollision(scene, hitEntity, entity.id(), -outInfo.normal[0], -outInfo.normal[1], -outInfo.normal[2], outInfo.travel);
+        emitCollision(world, entity.id(), hitEntity, outInfo.normal[0], outInfo.normal[1], outInfo.normal[2], outInfo.travel);
+        emitCollision(world, hitEntity, entity.id(), -outInfo.normal[0], -outInfo.normal[1], -outInfo.normal[2], outInfo.travel);
+        world.events().dispatch(*scene);
         return true;
     }
 
@@ -1376,71 +1144,46 @@ namespace Melkam
         const float dx = motion[0];
         const float dy = motion[1];
         const float dz = motion[2];
-        const auto all = scene->view<TransformComponent, ColliderComponent>();
+        auto &world = PhysicsWorld::get(*scene);
+        world.syncIfStale(*scene);
+
+        const auto *moverLayers = entity.tryGetComponent<CollisionLayerComponent>();
 
         Aabb3D moverBox;
-        if (!getAabb3D(entity, *transform, moverBox))
+        if (!ComputeAabb3D(entity, *transform, moverBox))
         {
             return false;
         }
 
-        float bestTime = 1.0f;
-        float hitNx = 0.0f;
-        float hitNy = 0.0f;
-        float hitNz = 0.0f;
-        EntityId hitEntity = InvalidEntity;
-        Aabb3D hitBox{};
-
-        for (auto &other : all)
+        // Unlike the other movers this one has always collided with triggers too.
+        auto &candidates = t_candidates3D;
+        auto &meshes = t_meshCandidates;
+        candidates.clear();
+        meshes.clear();
+        world.query3D(SweptAabb(moverBox, dx, dy, dz), LayerBits(moverLayers), MaskBits(moverLayers), [&](EntityId otherId, const Aabb3D &otherBox)
         {
-            if (other.id() == entity.id())
-            {
-                continue;
-            }
-
-            auto *otherCollider = other.tryGetComponent<ColliderComponent>();
-            auto *otherTransform = other.tryGetComponent<TransformComponent>();
-            if (!otherCollider || !otherTransform || otherCollider->is2D)
-            {
-                continue;
-            }
-
-            if (!shouldCollide(entity.tryGetComponent<CollisionLayerComponent>(), other.tryGetComponent<CollisionLayerComponent>()))
-            {
-                continue;
-            }
-
-            Aabb3D otherBox;
-            if (!getAabb3D(other, *otherTransform, otherBox))
+            if (otherId != entity.id() && scene->isValid(otherId))
             {
-                continue;
+                pushCandidate(world, candidates, meshes, otherId, otherBox);
             }
+        });
 
-            float time = 0.0f;
-            float nx = 0.0f;
-            float ny = 0.0f;
-            float nz = 0.0f;
-            if (!sweepAabb3D(moverBox, otherBox, dx, dy, dz, time, nx, ny, nz))
-            {
-                continue;
-            }
-
-            if (time < bestTime)
-            {
-                bestTime = time;
-                hitNx = nx;
-                hitNy = ny;
-                hitNz = nz;
-                hitEntity = other.id();
-                hitBox = otherBox;
-            }
-        }
+        SweepHit sweep = SweepAabbBatch(moverBox, dx, dy, dz, candidates);
+        EntityId hitEntity = sweep.hit ? candidates.ids[sweep.index] : InvalidEntity;
+        float meshDepth = 0.0f;
+        const bool meshHit = !meshes.empty() && SweepMeshCandidates(moverBox, motion, meshes, sweep, hitEntity, meshDepth);
+        const float bestTime = sweep.time;
+        float hitNx = sweep.normal[0];
+        float hitNy = sweep.normal[1];
+        float hitNz = sweep.normal[2];
+        const Aabb3D hitBox = sweep.hit && !meshHit ? candidates.box(sweep.index) : Aabb3D{};
 
         if (hitEntity == InvalidEntity)
         {
             transform->position.x += dx;
             transform->position.y += dy;
             transform->position.z += dz;
+            world.refresh(entity);
             return false;
         }
 
@@ -1454,10 +1197,19 @@ namespace Melkam
             transform->position.y += hitNy * s_settings.epsilon;
             transform->position.z += hitNz * s_settings.epsilon;
         }
+        else if (meshHit)
+        {
+            if (meshDepth > 0.0f)
+            {
+                transform->position.x += hitNx * (meshDepth + s_settings.epsilon);
+                transform->position.y += hitNy * (meshDepth + s_settings.epsilon);
+                transform->position.z += hitNz * (meshDepth + s_settings.epsilon);
+            }
+        }
         else
         {
             Aabb3D moverBox2;
-            if (getAabb3D(entity, *transform, moverBox2) && intersects(moverBox2, hitBox))
+            if (ComputeAabb3D(entity, *transform, moverBox2) && Intersects(moverBox2, hitBox))
             {
                 const float overlapX1 = hitBox.maxX - moverBox2.minX;
                 const float overlapX2 = moverBox2.maxX - hitBox.minX;
@@ -1500,6 +1252,7 @@ namespace Melkam
         }
 
         updateContactState(*collider, hitNx, hitNy, hitNz, false);
+        world.refresh(entity);
 
         outInfo.hit = true;
         outInfo.collider = hitEntity;
@@ -1507,8 +1260,9 @@ namespace Melkam
         outInfo.normal[1] = collider->lastNormal[1];
         outInfo.normal[2] = collider->lastNormal[2];
         outInfo.travel = std::sqrt((dx * bestTime) * (dx * bestTime) + (dy * bestTime) * (dy * bestTime) + (dz * bestTime) * (dz * bestTime));
-        emitCollision(scene, entity.id(), hitEntity, outInfo.normal[0], outInfo.normal[1], outInfo.normal[2], outInfo.travel);
-        emitCollision(scene, hitEntity, entity.id(), -outInfo.normal[0], -outInfo.normal[1], -outInfo.normal[2], outInfo.travel);
+        emitCollision(world, entity.id(), hitEntity, outInfo.normal[0], outInfo.normal[1], outInfo.normal[2], outInfo.travel);
+        emitCollision(world, hitEntity, entity.id(), -outInfo.normal[0], -outInfo.normal[1], -outInfo.normal[2], outInfo.travel);
+        world.events().dispatch(*scene);
         return true;
     }
 
@@ -1551,6 +1305,28 @@ namespace Melkam
         outNormal[2] = collider->lastNormal[2];
     }
 
+    void WakeRigidBody(const Entity &entity)
+    {
+        if (auto *scene = entity.scene())
+        {
+            auto &world = PhysicsWorld::get(*scene);
+            world.rigidBodies2D().wake(entity.id());
+            world.rigidBodies3D().wake(entity.id());
+        }
+    }
+
+    bool IsRigidBodySleeping(const Entity &entity)
+    {
+        auto *scene = entity.scene();
+        if (!scene)
+        {
+            return false;
+        }
+
+        auto &world = PhysicsWorld::get(*scene);
+        return world.rigidBodies2D().isSleeping(entity.id()) || world.rigidBodies3D().isSleeping(entity.id());
+    }
+
     void ConnectCollisionSignal(Entity entity, CollisionCallback callback)
     {
         if (!entity.isValid())
@@ -1558,7 +1334,7 @@ namespace Melkam
             return;
         }
 
-        s_collisionCallbacks[entity.id()].push_back(std::move(callback));
+        PhysicsWorld::get(*entity.scene()).events().connectCollision(entity.id(), std::move(callback));
     }
 
     void ConnectAreaBodyEntered(Entity area, AreaCallback callback)
@@ -1568,7 +1344,7 @@ namespace Melkam
             return;
         }
 
-        s_areaEnterCallbacks[area.id()].push_back(std::move(callback));
+        PhysicsWorld::get(*area.scene()).events().connectAreaEntered(area.id(), std::move(callback));
     }
 
     void ConnectAreaBodyExited(Entity area, AreaCallback callback)
@@ -1578,6 +1354,21 @@ namespace Melkam
             return;
         }
 
-        s_areaExitCallbacks[area.id()].push_back(std::move(callback));
+        PhysicsWorld::get(*area.scene()).events().connectAreaExited(area.id(), std::move(callback));
+    }
+
+    void ListenCollisions(Scene &scene, CollisionListener listener)
+    {
+        PhysicsWorld::get(scene).events().listenCollisions(std::move(listener));
+    }
+
+    void ListenAreaBodyEntered(Scene &scene, AreaListener listener)
+    {
+        PhysicsWorld::get(scene).events().listenAreaEntered(std::move(listener));
+    }
+
+    void ListenAreaBodyExited(Scene &scene, AreaListener listener)
+    {
+        PhysicsWorld::get(scene).events().listenAreaExited(std::move(listener));
     }
 }
@@ -0,0 +1,262 @@
+#include <Melkam/physics/ColliderProxies.hpp>
+
+#include <Melkam/physics/CollisionMesh.hpp>
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <algorithm>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Every pool whose adds and removals can create, drop or reshape a proxy.
+        std::uint64_t proxyRevision(const Scene &scene)
+        {
+            return scene.revision<ColliderComponent, TransformComponent, BoxShape2DComponent, CircleShape2DComponent,
+                                  BoxShape3DComponent, SphereShape3DComponent, CollisionMeshComponent, StaticBodyComponent,
+                                  StaticBody2DComponent, StaticBody3DComponent, Area2DComponent, Area3DComponent>();
+        }
+
+        bool sameProxy(const ColliderProxy &a, const ColliderProxy &b)
+        {
+            return a.bounds.minX == b.bounds.minX && a.bounds.minY == b.bounds.minY && a.bounds.minZ == b.bounds.minZ &&
+                   a.bounds.maxX == b.bounds.maxX && a.bounds.maxY == b.bounds.maxY && a.bounds.maxZ == b.bounds.maxZ &&
+                   a.layer == b.layer && a.mask == b.mask && a.shape == b.shape && a.flags == b.flags;
+        }
+
+        // Fills out from the entity's components. False when it has no proxy. A mesh already
+        // resolved for this entity is passed as knownMesh so the library is not asked again.
+        bool readProxy(const Entity &entity, const ColliderComponent &collider, const TransformComponent &transform, ColliderProxy &out,
+                       MeshShape &outMesh, const CollisionMesh *knownMesh = nullptr)
+        {
+            out.id = entity.id();
+            out.flags = 0u;
+            outMesh = {nullptr, {0.0f, 0.0f, 0.0f}, false};
+            if (collider.is2D)
+            {
+                Aabb2D box;
+                if (!ComputeAabb2D(entity, transform, box))
+                {
+                    return false;
+                }
+
+                out.bounds = {box.minX, box.minY, 0.0f, box.maxX, box.maxY, 0.0f};
+                out.shape = entity.hasComponent<BoxShape2DComponent>() ? ShapeKind::Box2D : ShapeKind::Circle2D;
+                out.flags |= ColliderProxy::Is2D;
+                if (entity.hasComponent<Area2DComponent>())
+                {
+                    out.flags |= ColliderProxy::Area;
+                }
+            }
+            else
+            {
+                if (entity.hasComponent<BoxShape3DComponent>() || entity.hasComponent<SphereShape3DComponent>())
+                {
+                    if (!ComputeAabb3D(entity, transform, out.bounds))
+                    {
+                        return false;
+                    }
+                    out.shape = entity.hasComponent<BoxShape3DComponent>() ? ShapeKind::Box3D : ShapeKind::Sphere3D;
+                }
+                else
+                {
+                    // The one library lookup per mesh; ComputeAabb3D reads the result back from here.
+                    const CollisionMesh *mesh = knownMesh ? knownMesh : LoadCollisionMesh(entity);
+                    if (!mesh)
+                    {
+                        return false;
+                    }
+
+                    const Vector3f origin = WorldPosition(entity, transform.position);
+                    out.bounds = OffsetAabb(mesh->bounds(), origin);
+                    out.shape = ShapeKind::Mesh3D;
+                    outMesh = {mesh, {origin.x, origin.y, origin.z}, !entity.tryGetComponent<CollisionMeshComponent>()->convex};
+                }
+                if (entity.hasComponent<Area3DComponent>())
+                {
+                    out.flags |= ColliderProxy::Area;
+                }
+            }
+
+            if (collider.isTrigger)
+            {
+                out.flags |= ColliderProxy::Trigger;
+            }
+            if (IsStaticBody(entity))
+            {
+                out.flags |= ColliderProxy::Static;
+            }
+
+            const auto *layers = entity.tryGetComponent<CollisionLayerComponent>();
+            out.layer = LayerBits(layers);
+            out.mask = MaskBits(layers);
+            return true;
+        }
+
+        // The wall set Physics2DSystem collided with before 2D colliders: Transform, BoxShape2D and
+        // StaticBody, with no ColliderComponent.
+        bool readBareWall(const Entity &entity, const TransformComponent &transform, ColliderProxy &out, MeshShape &outMesh)
+        {
+            Aabb2D box;
+            if (!entity.hasComponent<BoxShape2DComponent>() || !entity.hasComponent<StaticBodyComponent>() ||
+                !ComputeAabb2D(entity, transform, box))
+            {
+                return false;
+            }
+
+            const auto *layers = entity.tryGetComponent<CollisionLayerComponent>();
+            out.bounds = {box.minX, box.minY, 0.0f, box.maxX, box.maxY, 0.0f};
+            out.id = entity.id();
+            out.layer = LayerBits(layers);
+            out.mask = MaskBits(layers);
+            out.shape = ShapeKind::Box2D;
+            out.flags = ColliderProxy::Is2D | ColliderProxy::Static | ColliderProxy::Bare;
+            outMesh = {nullptr, {0.0f, 0.0f, 0.0f}, false};
+            return true;
+        }
+    }
+
+    bool ColliderProxies::sync(Scene &scene, std::vector<EntityId> &changed)
+    {
+        const std::uint64_t revision = proxyRevision(scene);
+        if (m_built && revision == m_revision && patch(scene, changed))
+        {
+            return false;
+        }
+
+        rebuild(scene);
+        return true;
+    }
+
+    void ColliderProxies::rebuild(Scene &scene)
+    {
+        m_revision = proxyRevision(scene);
+        m_built = true;
+        m_proxies.clear();
+        m_meshShapes.clear();
+        std::fill(m_lookup.begin(), m_lookup.end(), 0u);
+        scene.view<ColliderComponent, TransformComponent>().each(
+            [this](Entity entity, ColliderComponent &collider, TransformComponent &transform)
+            {
+                ColliderProxy proxy;
+                MeshShape meshShape;
+                if (readProxy(entity, collider, transform, proxy, meshShape))
+                {
+                    store(proxy, meshShape);
+                }
+            });
+        scene.view<BoxShape2DComponent, StaticBodyComponent, TransformComponent>().each(
+            [this](Entity entity, BoxShape2DComponent &, StaticBodyComponent &, TransformComponent &transform)
+            {
+                ColliderProxy proxy;
+                MeshShape meshShape;
+                if (!entity.hasComponent<ColliderComponent>() && readBareWall(entity, transform, proxy, meshShape))
+                {
+                    store(proxy, meshShape);
+                }
+            });
+    }
+
+    bool ColliderProxies::patch(Scene &scene, std::vector<EntityId> &changed)
+    {
+        const std::size_t first = changed.size();
+        for (std::size_t i = 0; i < m_proxies.size(); ++i)
+        {
+            ColliderProxy &proxy = m_proxies[i];
+            const Entity entity(&scene, proxy.id);
+            const auto *transform = scene.tryGetComponent<TransformComponent>(proxy.id);
+            const auto *collider = scene.tryGetComponent<ColliderComponent>(proxy.id);
+            ColliderProxy current;
+            MeshShape meshShape;
+            const bool read = transform && (collider ? readProxy(entity, *collider, *transform, current, meshShape, m_meshShapes[i].mesh)
+                                                     : readBareWall(entity, *transform, current, meshShape));
+            if (!read)
+            {
+                // A collider lost its shape in place, e.g. a 2D flag flipped on a 3D shape.
+                changed.resize(first);
+                return false;
+            }
+
+            if (!sameProxy(current, proxy))
+            {
+                proxy = current;
+                m_meshShapes[i] = meshShape;
+                changed.push_back(proxy.id);
+            }
+        }
+        return true;
+    }
+
+    void ColliderProxies::update(const Entity &entity)
+    {
+        const auto *collider = entity.tryGetComponent<ColliderComponent>();
+        const auto *transform = entity.tryGetComponent<TransformComponent>();
+        ColliderProxy proxy;
+        MeshShape meshShape;
+        const bool read = collider ? transform && readProxy(entity, *collider, *transform, proxy, meshShape)
+                                   : transform && readBareWall(entity, *transform, proxy, meshShape);
+        if (read)
+        {
+            store(proxy, meshShape);
+            return;
+        }
+        remove(entity.id());
+    }
+
+    void ColliderProxies::remove(EntityId id)
+    {
+        if (!find(id))
+        {
+            return;
+        }
+
+        // Swap-remove; the moved proxy takes over the slot.
+        const std::uint32_t slot = EntityIndex(id);
+        const std::uint32_t index = m_lookup[slot] - 1;
+        m_lookup[slot] = 0u;
+        if (index + 1 != m_proxies.size())
+        {
+            m_proxies[index] = m_proxies.back();
+            m_meshShapes[index] = m_meshShapes.back();
+            m_lookup[EntityIndex(m_proxies[index].id)] = index + 1;
+        }
+        m_proxies.pop_back();
+        m_meshShapes.pop_back();
+    }
+
+    void ColliderProxies::clear()
+    {
+        m_built = false;
+        m_proxies.clear();
+        m_meshShapes.clear();
+        m_lookup.clear();
+    }
+
+    void ColliderProxies::store(const ColliderProxy &proxy, const MeshShape &meshShape)
+    {
+        const std::uint32_t slot = EntityIndex(proxy.id);
+        if (slot >= m_lookup.size())
+        {
+            m_lookup.resize(slot + 1, 0u);
+        }
+
+        const std::uint32_t index = m_lookup[slot];
+        if (index != 0u && m_proxies[index - 1].id == proxy.id)
+        {
+            m_proxies[index - 1] = proxy;
+            m_meshShapes[index - 1] = meshShape;
+            return;
+        }
+
+        // New, or the slot's previous entity version is gone; its stale proxy goes first.
+        if (index != 0u)
+        {
+            remove(m_proxies[index - 1].id);
+        }
+        m_proxies.push_back(proxy);
+        m_meshShapes.push_back(meshShape);
+        m_lookup[slot] = static_cast<std::uint32_t>(m_proxies.size());
+    }
+}
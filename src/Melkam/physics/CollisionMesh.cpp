@@ -0,0 +1,745 @@
+#include <Melkam/physics/CollisionMesh.hpp>
+
+#include <Melkam/core/Logger.hpp>
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/scene/Entity.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Melkam
+{
+    // Internal nodes have count 0 and offset is the index of the first node after their subtree;
+    // their first child follows them. Leaves hold triangles [offset, offset + count).
+    struct CollisionMeshNode
+    {
+        Aabb3D box;
+        std::uint32_t offset;
+        std::uint32_t count;
+    };
+
+    static_assert(sizeof(CollisionMeshNode) == 32, "cooked nodes are 32 bytes");
+
+    namespace
+    {
+        // "MCM1" in little-endian byte order.
+        constexpr std::uint32_t CookedMagic = 0x314D434Du;
+        constexpr std::uint32_t CookedVersion = 1;
+        constexpr std::uint32_t LeafSize = 4;
+
+        struct CookedHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t nodeCount;
+            std::uint32_t triangleCount;
+            std::uint32_t vertexCount;
+            std::uint32_t reserved;
+            Aabb3D bounds;
+        };
+
+        static_assert(sizeof(CookedHeader) == 48, "the cooked header is 48 bytes");
+
+        struct CookTriangle
+        {
+            std::uint32_t vertices[3];
+            std::uint32_t index;
+            float center[3];
+            Aabb3D box;
+        };
+
+        Aabb3D merge(const Aabb3D &a, const Aabb3D &b)
+        {
+            return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::min(a.minZ, b.minZ),
+                    std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY), std::max(a.maxZ, b.maxZ)};
+        }
+
+        void cross(const float a[3], const float b[3], float out[3])
+        {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        float dot(const float a[3], const float b[3])
+        {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        // Same split as StaticBvh: median on the axis where the centres spread furthest.
+        void buildRange(std::vector<CookTriangle> &triangles, std::size_t begin, std::size_t end, std::vector<CollisionMeshNode> &nodes)
+        {
+            const std::uint32_t nodeIndex = static_cast<std::uint32_t>(nodes.size());
+            nodes.emplace_back();
+
+            Aabb3D box = triangles[begin].box;
+            float lo[3] = {triangles[begin].center[0], triangles[begin].center[1], triangles[begin].center[2]};
+            float hi[3] = {lo[0], lo[1], lo[2]};
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                box = merge(box, triangles[i].box);
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    lo[axis] = std::min(lo[axis], triangles[i].center[axis]);
+                    hi[axis] = std::max(hi[axis], triangles[i].center[axis]);
+                }
+            }
+
+            if (end - begin <= LeafSize)
+            {
+                nodes[nodeIndex] = {box, static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end - begin)};
+                return;
+            }
+
+            int axis = 0;
+            for (int candidate = 1; candidate < 3; ++candidate)
+            {
+                if (hi[candidate] - lo[candidate] > hi[axis] - lo[axis])
+                {
+                    axis = candidate;
+                }
+            }
+
+            const std::size_t middle = begin + (end - begin) / 2;
+            std::nth_element(triangles.begin() + begin, triangles.begin() + middle, triangles.begin() + end,
+                             [axis](const CookTriangle &a, const CookTriangle &b)
+                             {
+                                 return a.center[axis] < b.center[axis] || (a.center[axis] == b.center[axis] && a.index < b.index);
+                             });
+
+            buildRange(triangles, begin, middle, nodes);
+            buildRange(triangles, middle, end, nodes);
+            nodes[nodeIndex] = {box, static_cast<std::uint32_t>(nodes.size()), 0u};
+        }
+
+        // Calls visit(triangle) for every triangle in a leaf that box touches while moving by
+        // motion no later than limit, which visit may lower as hits come in.
+        template <typename Visit>
+        void walk(const CollisionMeshNode *nodes, std::uint32_t count, const Aabb3D &box, const float motion[3], const float &limit,
+                  Visit &&visit)
+        {
+            std::uint32_t index = 0;
+            while (index < count)
+            {
+                const CollisionMeshNode &node = nodes[index];
+                float enter = 0.0f;
+                float exit = limit;
+                const bool touches = SweepInterval(box.minX, box.maxX, motion[0], node.box.minX, node.box.maxX, enter, exit) &&
+                                     SweepInterval(box.minY, box.maxY, motion[1], node.box.minY, node.box.maxY, enter, exit) &&
+                                     SweepInterval(box.minZ, box.maxZ, motion[2], node.box.minZ, node.box.maxZ, enter, exit);
+                if (!touches)
+                {
+                    index = node.count == 0u ? node.offset : index + 1;
+                    continue;
+                }
+
+                for (std::uint32_t triangle = node.offset; triangle < node.offset + node.count; ++triangle)
+                {
+                    visit(triangle);
+                }
+                ++index;
+            }
+        }
+
+        // Separating-axis sweep of a box (half extents, centred on the origin) against a
+        // triangle given relative to the box centre. The box axes, the triangle normal, the
+        // edge-axis crosses and the in-plane edge normals together separate any disjoint pair,
+        // even a box without extent.
+        bool sweepTriangle(const float half[3], const float p[3][3], const float motion[3], MeshHit &outHit)
+        {
+            const float inf = std::numeric_limits<float>::infinity();
+            const float edges[3][3] = {{p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]},
+                                       {p[2][0] - p[1][0], p[2][1] - p[1][1], p[2][2] - p[1][2]},
+                                       {p[0][0] - p[2][0], p[0][1] - p[2][1], p[0][2] - p[2][2]}};
+            float normal[3];
+            cross(edges[0], edges[1], normal);
+
+            float enter = -inf;
+            float exit = inf;
+            float enterNormal[3] = {0.0f, 0.0f, 0.0f};
+            float depth = inf;
+            float depthNormal[3] = {0.0f, 0.0f, 0.0f};
+
+            // False once the axis separates the pair for the whole motion.
+            const auto testAxis = [&](const float axis[3], float minLengthSq)
+            {
+                const float lengthSq = dot(axis, axis);
+                if (lengthSq <= minLengthSq)
+                {
+                    // Near-parallel cross product; other axes cover its direction.
+                    return true;
+                }
+
+                const float radius = half[0] * std::abs(axis[0]) + half[1] * std::abs(axis[1]) + half[2] * std::abs(axis[2]);
+                const float d0 = dot(p[0], axis);
+                const float d1 = dot(p[1], axis);
+                const float d2 = dot(p[2], axis);
+                // The box centre's offset along axis overlaps the triangle strictly inside (lo, hi).
+                const float lo = std::min(d0, std::min(d1, d2)) - radius;
+                const float hi = std::max(d0, std::max(d1, d2)) + radius;
+                const float invLength = 1.0f / std::sqrt(lengthSq);
+
+                if (lo < 0.0f && hi > 0.0f)
+                {
+                    const bool down = -lo < hi;
+                    const float axisDepth = (down ? -lo : hi) * invLength;
+                    if (axisDepth < depth)
+                    {
+                        const float sign = down ? -invLength : invLength;
+                        depth = axisDepth;
+                        depthNormal[0] = axis[0] * sign;
+                        depthNormal[1] = axis[1] * sign;
+                        depthNormal[2] = axis[2] * sign;
+                    }
+                }
+
+                const float d = dot(motion, axis);
+                if (d == 0.0f)
+                {
+                    return lo < 0.0f && hi > 0.0f;
+                }
+
+                const float t0 = lo / d;
+                const float t1 = hi / d;
+                const float axisEnter = std::min(t0, t1);
+                if (axisEnter > enter)
+                {
+                    const float sign = d > 0.0f ? -invLength : invLength;
+                    enter = axisEnter;
+                    enterNormal[0] = axis[0] * sign;
+                    enterNormal[1] = axis[1] * sign;
+                    enterNormal[2] = axis[2] * sign;
+                }
+                exit = std::min(exit, std::max(t0, t1));
+                return enter <= exit && enter <= 1.0f && exit >= 0.0f;
+            };
+
+            constexpr float Parallel = 1e-10f;
+            const float boxAxes[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+            for (const auto &axis : boxAxes)
+            {
+                if (!testAxis(axis, 0.0f))
+                {
+                    return false;
+                }
+            }
+            if (!testAxis(normal, 0.0f))
+            {
+                return false;
+            }
+
+            for (const auto &edge : edges)
+            {
+                const float edgeLengthSq = dot(edge, edge);
+                for (const auto &boxAxis : boxAxes)
+                {
+                    float axis[3];
+                    cross(edge, boxAxis, axis);
+                    if (!testAxis(axis, Parallel * edgeLengthSq))
+                    {
+                        return false;
+                    }
+                }
+
+                float inPlane[3];
+                cross(normal, edge, inPlane);
+                if (!testAxis(inPlane, 0.0f))
+                {
+                    return false;
+                }
+            }
+
+            // Overlapping on every axis at the start: push out along the shallowest one.
+            if (enter < 0.0f && exit > 0.0f)
+            {
+                outHit.time = 0.0f;
+                outHit.depth = depth;
+                std::memcpy(outHit.normal, depthNormal, sizeof(depthNormal));
+                return true;
+            }
+
+            if (enter < 0.0f)
+            {
+                return false;
+            }
+
+            outHit.time = enter;
+            outHit.depth = 0.0f;
+            std::memcpy(outHit.normal, enterNormal, sizeof(enterNormal));
+            return true;
+        }
+
+        // Two-sided Moller-Trumbore; time is a fraction of motion.
+        bool rayTriangle(const float origin[3], const float motion[3], const float a[3], const float b[3], const float c[3],
+                         float &outTime, float outNormal[3])
+        {
+            const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            float pvec[3];
+            cross(motion, e2, pvec);
+            const float det = dot(e1, pvec);
+            if (det == 0.0f)
+            {
+                return false;
+            }
+
+            const float invDet = 1.0f / det;
+            const float tvec[3] = {origin[0] - a[0], origin[1] - a[1], origin[2] - a[2]};
+            const float u = dot(tvec, pvec) * invDet;
+            if (u < 0.0f || u > 1.0f)
+            {
+                return false;
+            }
+
+            float qvec[3];
+            cross(tvec, e1, qvec);
+            const float v = dot(motion, qvec) * invDet;
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                return false;
+            }
+
+            const float t = dot(e2, qvec) * invDet;
+            if (t < 0.0f || t > 1.0f)
+            {
+                return false;
+            }
+
+            float normal[3];
+            cross(e1, e2, normal);
+            const float length = std::sqrt(dot(normal, normal));
+            const float sign = dot(normal, motion) > 0.0f ? -1.0f / length : 1.0f / length;
+            outNormal[0] = normal[0] * sign;
+            outNormal[1] = normal[1] * sign;
+            outNormal[2] = normal[2] * sign;
+            outTime = t;
+            return true;
+        }
+    }
+
+    bool CookCollisionMesh(const float *positions, std::size_t vertexCount, const std::uint32_t *indices, std::size_t indexCount,
+                           std::vector<std::uint8_t> &outData)
+    {
+        outData.clear();
+        if (!positions || !indices || vertexCount == 0 || vertexCount > std::numeric_limits<std::uint32_t>::max() ||
+            indexCount / 3 > std::numeric_limits<std::uint32_t>::max())
+        {
+            return false;
+        }
+
+        std::vector<CookTriangle> triangles;
+        triangles.reserve(indexCount / 3);
+        for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            CookTriangle triangle;
+            const float *corners[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                if (indices[i + k] >= vertexCount)
+                {
+                    return false;
+                }
+                triangle.vertices[k] = indices[i + k];
+                corners[k] = positions + 3 * static_cast<std::size_t>(indices[i + k]);
+            }
+
+            const float e1[3] = {corners[1][0] - corners[0][0], corners[1][1] - corners[0][1], corners[1][2] - corners[0][2]};
+            const float e2[3] = {corners[2][0] - corners[0][0], corners[2][1] - corners[0][1], corners[2][2] - corners[0][2]};
+            float normal[3];
+            cross(e1, e2, normal);
+            if (dot(normal, normal) == 0.0f)
+            {
+                continue;
+            }
+
+            triangle.index = static_cast<std::uint32_t>(triangles.size());
+            triangle.box = {corners[0][0], corners[0][1], corners[0][2], corners[0][0], corners[0][1], corners[0][2]};
+            for (int k = 1; k < 3; ++k)
+            {
+                triangle.box = merge(triangle.box, {corners[k][0], corners[k][1], corners[k][2], corners[k][0], corners[k][1], corners[k][2]});
+            }
+            triangle.center[0] = 0.5f * (triangle.box.minX + triangle.box.maxX);
+            triangle.center[1] = 0.5f * (triangle.box.minY + triangle.box.maxY);
+            triangle.center[2] = 0.5f * (triangle.box.minZ + triangle.box.maxZ);
+            triangles.push_back(triangle);
+        }
+
+        if (triangles.empty())
+        {
+            return false;
+        }
+
+        std::vector<CollisionMeshNode> nodes;
+        nodes.reserve(2 * triangles.size() / LeafSize + 1);
+        buildRange(triangles, 0, triangles.size(), nodes);
+
+        CookedHeader header{};
+        header.magic = CookedMagic;
+        header.version = CookedVersion;
+        header.nodeCount = static_cast<std::uint32_t>(nodes.size());
+        header.triangleCount = static_cast<std::uint32_t>(triangles.size());
+        header.vertexCount = static_cast<std::uint32_t>(vertexCount);
+        header.bounds = nodes[0].box;
+
+        const std::size_t nodeBytes = nodes.size() * sizeof(CollisionMeshNode);
+        const std::size_t triangleBytes = triangles.size() * 3 * sizeof(std::uint32_t);
+        const std::size_t vertexBytes = vertexCount * 3 * sizeof(float);
+        outData.resize(sizeof(CookedHeader) + nodeBytes + triangleBytes + vertexBytes);
+
+        std::uint8_t *cursor = outData.data();
+        std::memcpy(cursor, &header, sizeof(header));
+        cursor += sizeof(header);
+        std::memcpy(cursor, nodes.data(), nodeBytes);
+        cursor += nodeBytes;
+        for (const CookTriangle &triangle : triangles)
+        {
+            std::memcpy(cursor, triangle.vertices, sizeof(triangle.vertices));
+            cursor += sizeof(triangle.vertices);
+        }
+        std::memcpy(cursor, positions, vertexBytes);
+        return true;
+    }
+
+    bool WriteCookedCollisionMesh(const std::string &path, const std::vector<std::uint8_t> &data)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+
+        const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+    CollisionMesh::~CollisionMesh()
+    {
+        reset();
+    }
+
+    bool CollisionMesh::map(const std::string &path)
+    {
+        reset();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // The view keeps the file mapped after both handles are closed.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            return false;
+        }
+
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+        {
+            return false;
+        }
+        const std::size_t size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size <= 0)
+        {
+            close(file);
+            return false;
+        }
+
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+#endif
+
+        m_mapped = view;
+        m_mappedSize = size;
+        if (!attach(static_cast<const std::uint8_t *>(view), size))
+        {
+            reset();
+            return false;
+        }
+        return true;
+    }
+
+    bool CollisionMesh::load(std::vector<std::uint8_t> data)
+    {
+        reset();
+        m_owned = std::move(data);
+        if (!attach(m_owned.data(), m_owned.size()))
+        {
+            reset();
+            return false;
+        }
+        return true;
+    }
+
+    void CollisionMesh::reset()
+    {
+        if (m_mapped)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(m_mapped);
+#else
+            munmap(m_mapped, m_mappedSize);
+#endif
+        }
+
+        m_mapped = nullptr;
+        m_mappedSize = 0;
+        m_owned.clear();
+        m_owned.shrink_to_fit();
+        m_nodes = nullptr;
+        m_triangles = nullptr;
+        m_vertices = nullptr;
+        m_nodeCount = 0;
+        m_triangleCount = 0;
+        m_bounds = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    }
+
+    bool CollisionMesh::attach(const std::uint8_t *data, std::size_t size)
+    {
+        if (!data || size < sizeof(CookedHeader) || reinterpret_cast<std::uintptr_t>(data) % alignof(CollisionMeshNode) != 0)
+        {
+            return false;
+        }
+
+        CookedHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != CookedMagic || header.version != CookedVersion || header.nodeCount == 0 || header.triangleCount == 0 ||
+            header.vertexCount == 0)
+        {
+            return false;
+        }
+
+        const std::uint64_t expected = sizeof(CookedHeader) + std::uint64_t(header.nodeCount) * sizeof(CollisionMeshNode) +
+                                       std::uint64_t(header.triangleCount) * 3 * sizeof(std::uint32_t) +
+                                       std::uint64_t(header.vertexCount) * 3 * sizeof(float);
+        if (expected != size)
+        {
+            return false;
+        }
+
+        const auto *nodes = reinterpret_cast<const CollisionMeshNode *>(data + sizeof(CookedHeader));
+        const auto *triangles = reinterpret_cast<const std::uint32_t *>(nodes + header.nodeCount);
+        const auto *vertices = reinterpret_cast<const float *>(triangles + std::size_t(header.triangleCount) * 3);
+
+        // Internal nodes must skip forward past at least one child; leaves must stay in range.
+        for (std::uint32_t i = 0; i < header.nodeCount; ++i)
+        {
+            const CollisionMeshNode &node = nodes[i];
+            const bool valid = node.count == 0u ? node.offset > i + 1 && node.offset <= header.nodeCount
+                                                : std::uint64_t(node.offset) + node.count <= header.triangleCount;
+            if (!valid)
+            {
+                return false;
+            }
+        }
+
+        for (std::size_t i = 0; i < std::size_t(header.triangleCount) * 3; ++i)
+        {
+            if (triangles[i] >= header.vertexCount)
+            {
+                return false;
+            }
+        }
+
+        m_nodes = nodes;
+        m_triangles = triangles;
+        m_vertices = vertices;
+        m_nodeCount = header.nodeCount;
+        m_triangleCount = header.triangleCount;
+        m_bounds = header.bounds;
+        return true;
+    }
+
+    bool CollisionMesh::raycast(const float origin[3], const float motion[3], MeshHit &outHit) const
+    {
+        outHit = MeshHit{};
+        if (!isLoaded() || (motion[0] == 0.0f && motion[1] == 0.0f && motion[2] == 0.0f))
+        {
+            return false;
+        }
+
+        const Aabb3D point = {origin[0], origin[1], origin[2], origin[0], origin[1], origin[2]};
+        float best = 1.0f;
+        walk(m_nodes, m_nodeCount, point, motion, best,
+             [&](std::uint32_t triangle)
+             {
+                 const std::uint32_t *corners = m_triangles + 3 * std::size_t(triangle);
+                 float time;
+                 float normal[3];
+                 if (!rayTriangle(origin, motion, m_vertices + 3 * std::size_t(corners[0]), m_vertices + 3 * std::size_t(corners[1]),
+                                  m_vertices + 3 * std::size_t(corners[2]), time, normal))
+                 {
+                     return;
+                 }
+
+                 if (outHit.hit && (time > best || (time == best && triangle > outHit.triangle)))
+                 {
+                     return;
+                 }
+
+                 outHit.hit = true;
+                 outHit.triangle = triangle;
+                 outHit.time = time;
+                 std::memcpy(outHit.normal, normal, sizeof(normal));
+                 best = time;
+             });
+        return outHit.hit;
+    }
+
+    bool CollisionMesh::sweepAabb(const Aabb3D &box, const float motion[3], MeshHit &outHit) const
+    {
+        if (box.minX == box.maxX && box.minY == box.maxY && box.minZ == box.maxZ)
+        {
+            const float origin[3] = {box.minX, box.minY, box.minZ};
+            return raycast(origin, motion, outHit);
+        }
+
+        outHit = MeshHit{};
+        if (!isLoaded() || (motion[0] == 0.0f && motion[1] == 0.0f && motion[2] == 0.0f))
+        {
+            return false;
+        }
+
+        // Triangles are taken relative to the box centre, which keeps the projections small.
+        const float center[3] = {0.5f * (box.minX + box.maxX), 0.5f * (box.minY + box.maxY), 0.5f * (box.minZ + box.maxZ)};
+        const float half[3] = {0.5f * (box.maxX - box.minX), 0.5f * (box.maxY - box.minY), 0.5f * (box.maxZ - box.minZ)};
+        float best = 1.0f;
+        walk(m_nodes, m_nodeCount, box, motion, best,
+             [&](std::uint32_t triangle)
+             {
+                 const std::uint32_t *corners = m_triangles + 3 * std::size_t(triangle);
+                 float p[3][3];
+                 for (int k = 0; k < 3; ++k)
+                 {
+                     const float *vertex = m_vertices + 3 * std::size_t(corners[k]);
+                     p[k][0] = vertex[0] - center[0];
+                     p[k][1] = vertex[1] - center[1];
+                     p[k][2] = vertex[2] - center[2];
+                 }
+
+                 MeshHit hit;
+                 if (!sweepTriangle(half, p, motion, hit))
+                 {
+                     return;
+                 }
+
+                 if (outHit.hit && (hit.time > best || (hit.time == best && triangle > outHit.triangle)))
+                 {
+                     return;
+                 }
+
+                 hit.hit = true;
+                 hit.triangle = triangle;
+                 outHit = hit;
+                 best = hit.time;
+             });
+        return outHit.hit;
+    }
+
+    const CollisionMesh *CollisionMeshLibrary::load(const std::string &asset)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_meshes.find(asset);
+        if (it != m_meshes.end())
+        {
+            return it->second.get();
+        }
+
+        // Failures are remembered as null so they are reported once.
+        auto mesh = std::make_unique<CollisionMesh>();
+        if (!mesh->map(asset))
+        {
+            Logger::Warn("Collision mesh '" + asset + "' is missing or not a cooked mesh.");
+            mesh.reset();
+        }
+
+        const CollisionMesh *result = mesh.get();
+        m_meshes.emplace(asset, std::move(mesh));
+        return result;
+    }
+
+    const CollisionMesh *LoadCollisionMesh(const Entity &entity)
+    {
+        const auto *shape = entity.tryGetComponent<CollisionMeshComponent>();
+        Scene *scene = entity.scene();
+        if (!shape || !scene || shape->meshAsset.empty())
+        {
+            return nullptr;
+        }
+
+        return PhysicsWorld::get(*scene).meshes().load(shape->meshAsset);
+    }
+
+    bool SweepMeshCandidates(const Aabb3D &mover, const float motion[3], const std::vector<MeshCandidate> &meshes,
+                             SweepHit &best, EntityId &bestId, float &outDepth)
+    {
+        bool won = false;
+        for (const MeshCandidate &candidate : meshes)
+        {
+            const float *origin = candidate.origin;
+            const Aabb3D local = {mover.minX - origin[0], mover.minY - origin[1], mover.minZ - origin[2],
+                                  mover.maxX - origin[0], mover.maxY - origin[1], mover.maxZ - origin[2]};
+            MeshHit hit;
+            if (!candidate.mesh->sweepAabb(local, motion, hit))
+            {
+                continue;
+            }
+
+            if (best.hit && (hit.time > best.time || (hit.time == best.time && candidate.id > bestId)))
+            {
+                continue;
+            }
+
+            best.hit = true;
+            best.time = hit.time;
+            std::memcpy(best.normal, hit.normal, sizeof(hit.normal));
+            bestId = candidate.id;
+            outDepth = hit.depth;
+            won = true;
+        }
+        return won;
+    }
+}
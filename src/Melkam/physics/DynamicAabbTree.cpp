@@ -0,0 +1,381 @@
+#include <Melkam/physics/DynamicAabbTree.hpp>
+
+#include <algorithm>
+
+namespace Melkam
+{
+    namespace
+    {
+        Aabb3D merge(const Aabb3D &a, const Aabb3D &b)
+        {
+            return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::min(a.minZ, b.minZ),
+                    std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY), std::max(a.maxZ, b.maxZ)};
+        }
+
+        float surfaceArea(const Aabb3D &box)
+        {
+            const float dx = box.maxX - box.minX;
+            const float dy = box.maxY - box.minY;
+            const float dz = box.maxZ - box.minZ;
+            return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+
+        bool containsBox(const Aabb3D &outer, const Aabb3D &inner)
+        {
+            return outer.minX <= inner.minX && outer.minY <= inner.minY && outer.minZ <= inner.minZ &&
+                   inner.maxX <= outer.maxX && inner.maxY <= outer.maxY && inner.maxZ <= outer.maxZ;
+        }
+    }
+
+    DynamicAabbTree::DynamicAabbTree(float margin)
+        : m_margin(std::max(0.0f, margin))
+    {
+    }
+
+    void DynamicAabbTree::update(EntityId id, const Aabb3D &box, std::uint32_t layer, std::uint32_t mask)
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size())
+        {
+            m_lookup.resize(slot + 1, Null);
+        }
+
+        std::int32_t leaf = m_lookup[slot];
+        if (leaf != Null && m_nodes[leaf].id != id)
+        {
+            // Slot reused by a newer entity version; drop the stale leaf.
+            destroyLeaf(leaf);
+            leaf = Null;
+        }
+
+        const Aabb3D fat{box.minX - m_margin, box.minY - m_margin, box.minZ - m_margin,
+                         box.maxX + m_margin, box.maxY + m_margin, box.maxZ + m_margin};
+
+        if (leaf == Null)
+        {
+            leaf = allocateNode();
+            Node &node = m_nodes[leaf];
+            node.box = fat;
+            node.tight = box;
+            node.height = 0;
+            node.id = id;
+            node.layer = layer;
+            node.mask = mask;
+            node.layers = layer;
+            node.sync = m_sync;
+            m_lookup[slot] = leaf;
+            ++m_leafCount;
+            insertLeaf(leaf);
+            return;
+        }
+
+        Node &node = m_nodes[leaf];
+        node.tight = box;
+        node.sync = m_sync;
+        if (node.layer != layer || node.mask != mask)
+        {
+            node.layer = layer;
+            node.mask = mask;
+            node.layers = layer;
+            for (std::int32_t index = node.parent; index != Null; index = m_nodes[index].parent)
+            {
+                refit(index);
+            }
+        }
+
+        if (containsBox(node.box, box))
+        {
+            return;
+        }
+
+        removeLeaf(leaf);
+        m_nodes[leaf].box = fat;
+        insertLeaf(leaf);
+    }
+
+    void DynamicAabbTree::remove(EntityId id)
+    {
+        const std::int32_t leaf = findLeaf(id);
+        if (leaf != Null)
+        {
+            destroyLeaf(leaf);
+        }
+    }
+
+    bool DynamicAabbTree::contains(EntityId id) const
+    {
+        return findLeaf(id) != Null;
+    }
+
+    void DynamicAabbTree::clear()
+    {
+        m_nodes.clear();
+        m_lookup.clear();
+        m_root = Null;
+        m_freeList = Null;
+        m_leafCount = 0;
+    }
+
+    void DynamicAabbTree::beginSync()
+    {
+        ++m_sync;
+    }
+
+    void DynamicAabbTree::endSync()
+    {
+        // Removal only frees nodes, it never allocates, so indices stay valid during the walk.
+        for (std::int32_t i = 0; i < static_cast<std::int32_t>(m_nodes.size()); ++i)
+        {
+            const Node &node = m_nodes[i];
+            if (node.height == 0 && node.sync != m_sync)
+            {
+                destroyLeaf(i);
+            }
+        }
+    }
+
+    std::int32_t DynamicAabbTree::allocateNode()
+    {
+        if (m_freeList == Null)
+        {
+            m_nodes.emplace_back();
+            return static_cast<std::int32_t>(m_nodes.size() - 1);
+        }
+
+        const std::int32_t index = m_freeList;
+        m_freeList = m_nodes[index].parent;
+        m_nodes[index] = Node{};
+        return index;
+    }
+
+    void DynamicAabbTree::freeNode(std::int32_t index)
+    {
+        Node &node = m_nodes[index];
+        node = Node{};
+        node.parent = m_freeList;
+        m_freeList = index;
+    }
+
+    void DynamicAabbTree::insertLeaf(std::int32_t leaf)
+    {
+        if (m_root == Null)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = Null;
+            return;
+        }
+
+        // Descend towards the cheapest sibling: the cost of a node is the area it would add to
+        // the tree, including the growth it causes in every ancestor on the way down.
+        const Aabb3D leafBox = m_nodes[leaf].box;
+        std::int32_t index = m_root;
+        while (!m_nodes[index].isLeaf())
+        {
+            const Node &node = m_nodes[index];
+            const float area = surfaceArea(node.box);
+            const float combinedArea = surfaceArea(merge(node.box, leafBox));
+
+            const float cost = 2.0f * combinedArea;
+            const float inheritance = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](std::int32_t child)
+            {
+                const Node &childNode = m_nodes[child];
+                const float merged = surfaceArea(merge(childNode.box, leafBox));
+                return childNode.isLeaf() ? merged + inheritance : (merged - surfaceArea(childNode.box)) + inheritance;
+            };
+
+            const float cost1 = descendCost(node.child1);
+            const float cost2 = descendCost(node.child2);
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const std::int32_t sibling = index;
+        const std::int32_t oldParent = m_nodes[sibling].parent;
+        const std::int32_t newParent = allocateNode();
+
+        Node &parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+        refit(newParent);
+
+        if (oldParent == Null)
+        {
+            m_root = newParent;
+        }
+        else if (m_nodes[oldParent].child1 == sibling)
+        {
+            m_nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            m_nodes[oldParent].child2 = newParent;
+        }
+
+        for (index = oldParent; index != Null; index = m_nodes[index].parent)
+        {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    void DynamicAabbTree::removeLeaf(std::int32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = Null;
+            return;
+        }
+
+        const std::int32_t parent = m_nodes[leaf].parent;
+        const std::int32_t grandParent = m_nodes[parent].parent;
+        const std::int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        if (grandParent == Null)
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = Null;
+            freeNode(parent);
+            return;
+        }
+
+        if (m_nodes[grandParent].child1 == parent)
+        {
+            m_nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        for (std::int32_t index = grandParent; index != Null; index = m_nodes[index].parent)
+        {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    void DynamicAabbTree::destroyLeaf(std::int32_t leaf)
+    {
+        const std::uint32_t slot = EntityIndex(m_nodes[leaf].id);
+        if (slot < m_lookup.size() && m_lookup[slot] == leaf)
+        {
+            m_lookup[slot] = Null;
+        }
+
+        removeLeaf(leaf);
+        freeNode(leaf);
+        --m_leafCount;
+    }
+
+    // Rotates the taller grandchild up when the children of index differ in height by more
+    // than one. Returns the node now at index's position.
+    std::int32_t DynamicAabbTree::balance(std::int32_t a)
+    {
+        Node &nodeA = m_nodes[a];
+        if (nodeA.isLeaf() || nodeA.height < 2)
+        {
+            return a;
+        }
+
+        const std::int32_t b = nodeA.child1;
+        const std::int32_t c = nodeA.child2;
+        const std::int32_t difference = m_nodes[c].height - m_nodes[b].height;
+
+        auto replaceInParent = [this](std::int32_t oldChild, std::int32_t newChild, std::int32_t parent)
+        {
+            if (parent == Null)
+            {
+                m_root = newChild;
+            }
+            else if (m_nodes[parent].child1 == oldChild)
+            {
+                m_nodes[parent].child1 = newChild;
+            }
+            else
+            {
+                m_nodes[parent].child2 = newChild;
+            }
+        };
+
+        if (difference > 1)
+        {
+            // Rotate C up; A keeps B and the shorter of C's children.
+            const std::int32_t f = m_nodes[c].child1;
+            const std::int32_t g = m_nodes[c].child2;
+
+            m_nodes[c].child1 = a;
+            m_nodes[c].parent = nodeA.parent;
+            nodeA.parent = c;
+            replaceInParent(a, c, m_nodes[c].parent);
+
+            const bool keepF = m_nodes[f].height > m_nodes[g].height;
+            const std::int32_t up = keepF ? f : g;
+            const std::int32_t down = keepF ? g : f;
+            m_nodes[c].child2 = up;
+            nodeA.child2 = down;
+            m_nodes[down].parent = a;
+
+            refit(a);
+            refit(c);
+            return c;
+        }
+
+        if (difference < -1)
+        {
+            // Rotate B up; A keeps C and the shorter of B's children.
+            const std::int32_t d = m_nodes[b].child1;
+            const std::int32_t e = m_nodes[b].child2;
+
+            m_nodes[b].child1 = a;
+            m_nodes[b].parent = nodeA.parent;
+            nodeA.parent = b;
+            replaceInParent(a, b, m_nodes[b].parent);
+
+            const bool keepD = m_nodes[d].height > m_nodes[e].height;
+            const std::int32_t up = keepD ? d : e;
+            const std::int32_t down = keepD ? e : d;
+            m_nodes[b].child2 = up;
+            nodeA.child1 = down;
+            m_nodes[down].parent = a;
+
+            refit(a);
+            refit(b);
+            return b;
+        }
+
+        return a;
+    }
+
+    void DynamicAabbTree::refit(std::int32_t index)
+    {
+        Node &node = m_nodes[index];
+        const Node &child1 = m_nodes[node.child1];
+        const Node &child2 = m_nodes[node.child2];
+        node.box = merge(child1.box, child2.box);
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.layers = child1.layers | child2.layers;
+    }
+
+    std::int32_t DynamicAabbTree::findLeaf(EntityId id) const
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size())
+        {
+            return Null;
+        }
+
+        const std::int32_t leaf = m_lookup[slot];
+        return leaf != Null && m_nodes[leaf].id == id ? leaf : Null;
+    }
+}
@@ -0,0 +1,212 @@
+#include <Melkam/physics/PhysicsEvents.hpp>
+
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <utility>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Slots may still hold a destroyed entity's callbacks; its successor in the slot drops them.
+        template <typename Slots, typename Callback>
+        void connect(Slots &slots, EntityId id, Callback callback)
+        {
+            const std::uint32_t index = EntityIndex(id);
+            if (index >= slots.size())
+            {
+                slots.resize(index + 1);
+            }
+
+            auto &slot = slots[index];
+            if (slot.owner != id)
+            {
+                slot.owner = id;
+                slot.callbacks.clear();
+            }
+            slot.callbacks.push_back(std::move(callback));
+        }
+
+        template <typename Slots>
+        const typename Slots::value_type *findSlot(const Slots &slots, EntityId id)
+        {
+            const std::uint32_t index = EntityIndex(id);
+            if (index >= slots.size() || slots[index].owner != id || slots[index].callbacks.empty())
+            {
+                return nullptr;
+            }
+            return &slots[index];
+        }
+
+        template <typename Listeners, typename Slots>
+        void deliverCollisions(Scene &scene, const std::vector<CollisionEvent> &batch, const Listeners &listeners, const Slots &slots)
+        {
+            for (const auto &listener : listeners)
+            {
+                if (listener)
+                {
+                    listener(scene, batch);
+                }
+            }
+
+            // Callbacks may destroy entities, so each event is checked again.
+            for (const CollisionEvent &event : batch)
+            {
+                const auto *slot = findSlot(slots, event.self);
+                if (!slot || !scene.isValid(event.self) || !scene.isValid(event.other))
+                {
+                    continue;
+                }
+
+                CollisionInfo info{};
+                info.hit = true;
+                info.collider = event.other;
+                info.normal[0] = event.normal[0];
+                info.normal[1] = event.normal[1];
+                info.normal[2] = event.normal[2];
+                info.travel = event.travel;
+
+                Entity self(&scene, event.self);
+                Entity other(&scene, event.other);
+                for (const auto &callback : slot->callbacks)
+                {
+                    if (callback)
+                    {
+                        callback(self, other, info);
+                    }
+                }
+            }
+        }
+
+        template <typename Listeners, typename Slots>
+        void deliverAreas(Scene &scene, const std::vector<AreaEvent> &batch, const Listeners &listeners, const Slots &slots)
+        {
+            for (const auto &listener : listeners)
+            {
+                if (listener)
+                {
+                    listener(scene, batch);
+                }
+            }
+
+            for (const AreaEvent &event : batch)
+            {
+                const auto *slot = findSlot(slots, event.area);
+                if (!slot || !scene.isValid(event.area) || !scene.isValid(event.body))
+                {
+                    continue;
+                }
+
+                Entity area(&scene, event.area);
+                Entity body(&scene, event.body);
+                for (const auto &callback : slot->callbacks)
+                {
+                    if (callback)
+                    {
+                        callback(area, body);
+                    }
+                }
+            }
+        }
+
+        // Drops events naming an entity that is gone, so listeners only see live ones.
+        template <typename Event, typename Valid>
+        void dropStale(std::vector<Event> &batch, Valid &&valid)
+        {
+            std::size_t kept = 0;
+            for (const Event &event : batch)
+            {
+                if (valid(event))
+                {
+                    batch[kept++] = event;
+                }
+            }
+            batch.resize(kept);
+        }
+    }
+
+    void PhysicsEvents::dispatch(Scene &scene)
+    {
+        if (m_dispatching)
+        {
+            return;
+        }
+        m_dispatching = true;
+
+        while (!m_collisions.empty() || !m_areaEntered.empty() || !m_areaExited.empty())
+        {
+            m_collisionBatch.clear();
+            m_collisionBatch.swap(m_collisions);
+            dropStale(m_collisionBatch, [&scene](const CollisionEvent &event)
+            {
+                return scene.isValid(event.self) && scene.isValid(event.other);
+            });
+            if (!m_collisionBatch.empty())
+            {
+                deliverCollisions(scene, m_collisionBatch, m_collisionListeners, m_collisionCallbacks);
+            }
+
+            const auto areaValid = [&scene](const AreaEvent &event)
+            {
+                return scene.isValid(event.area) && scene.isValid(event.body);
+            };
+
+            m_areaBatch.clear();
+            m_areaBatch.swap(m_areaEntered);
+            dropStale(m_areaBatch, areaValid);
+            if (!m_areaBatch.empty())
+            {
+                deliverAreas(scene, m_areaBatch, m_areaEnteredListeners, m_areaEnteredCallbacks);
+            }
+
+            m_areaBatch.clear();
+            m_areaBatch.swap(m_areaExited);
+            dropStale(m_areaBatch, areaValid);
+            if (!m_areaBatch.empty())
+            {
+                deliverAreas(scene, m_areaBatch, m_areaExitedListeners, m_areaExitedCallbacks);
+            }
+        }
+
+        m_collisionBatch.clear();
+        m_areaBatch.clear();
+        m_dispatching = false;
+    }
+
+    void PhysicsEvents::connectCollision(EntityId entity, CollisionCallback callback)
+    {
+        connect(m_collisionCallbacks, entity, std::move(callback));
+        m_wantsCollisions = true;
+    }
+
+    void PhysicsEvents::connectAreaEntered(EntityId area, AreaCallback callback)
+    {
+        connect(m_areaEnteredCallbacks, area, std::move(callback));
+        m_wantsAreaEntered = true;
+    }
+
+    void PhysicsEvents::connectAreaExited(EntityId area, AreaCallback callback)
+    {
+        connect(m_areaExitedCallbacks, area, std::move(callback));
+        m_wantsAreaExited = true;
+    }
+
+    void PhysicsEvents::listenCollisions(CollisionListener listener)
+    {
+        m_collisionListeners.push_back(std::move(listener));
+        m_wantsCollisions = true;
+    }
+
+    void PhysicsEvents::listenAreaEntered(AreaListener listener)
+    {
+        m_areaEnteredListeners.push_back(std::move(listener));
+        m_wantsAreaEntered = true;
+    }
+
+    void PhysicsEvents::listenAreaExited(AreaListener listener)
+    {
+        m_areaExitedListeners.push_back(std::move(listener));
+        m_wantsAreaExited = true;
+    }
+}
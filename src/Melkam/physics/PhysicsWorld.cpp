@@ -0,0 +1,270 @@
+#include <Melkam/physics/PhysicsWorld.hpp>
+
+#include <Melkam/physics/Bounds.hpp>
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+#include <Melkam/scene/System.hpp>
+
+#include <algorithm>
+
+namespace Melkam
+{
+    namespace
+    {
+        std::uint64_t staticRevision(const Scene &scene)
+        {
+            return scene.revision<StaticBodyComponent, StaticBody2DComponent, StaticBody3DComponent>();
+        }
+
+        bool sameBox(const Aabb3D &a, const Aabb3D &b)
+        {
+            return a.minX == b.minX && a.minY == b.minY && a.minZ == b.minZ && a.maxX == b.maxX && a.maxY == b.maxY && a.maxZ == b.maxZ;
+        }
+    }
+
+    void DeclarePhysicsWorldAccess(SystemAccess &access)
+    {
+        access.write<PhysicsWorldAccess>()
+            .read<NodeComponent, TransformComponent, WorldTransformComponent, ColliderComponent, CollisionLayerComponent,
+                  BoxShape2DComponent, CircleShape2DComponent, BoxShape3DComponent, SphereShape3DComponent, CollisionMeshComponent,
+                  StaticBodyComponent, StaticBody2DComponent, StaticBody3DComponent, Area2DComponent, Area3DComponent>();
+    }
+
+    PhysicsWorld &PhysicsWorld::get(Scene &scene)
+    {
+        return scene.context<PhysicsWorld>();
+    }
+
+    void PhysicsWorld::setFixedTimestep(float seconds)
+    {
+        m_fixedTimestep = std::max(0.0001f, seconds);
+    }
+
+    void PhysicsWorld::setMaxSubSteps(int steps)
+    {
+        m_maxSubSteps = std::max(1, steps);
+    }
+
+    int PhysicsWorld::accumulate(const Scene &scene, float dt)
+    {
+        if (m_clockStarted && m_clockFrame == scene.frame())
+        {
+            return m_clockSteps;
+        }
+        m_clockStarted = true;
+        m_clockFrame = scene.frame();
+
+        // Spiral-of-death guard: time beyond maxSubSteps steps is dropped, not carried over.
+        m_accumulator = std::min(m_accumulator + std::max(dt, 0.0f), m_fixedTimestep * static_cast<float>(m_maxSubSteps));
+
+        int steps = 0;
+        while (m_accumulator >= m_fixedTimestep && steps < m_maxSubSteps)
+        {
+            m_accumulator -= m_fixedTimestep;
+            ++steps;
+        }
+        m_clockSteps = steps;
+        return steps;
+    }
+
+    float PhysicsWorld::interpolationAlpha() const
+    {
+        return std::min(1.0f, m_accumulator / m_fixedTimestep);
+    }
+
+    void PhysicsWorld::sync(Scene &scene)
+    {
+        m_changed.clear();
+        const bool rebuilt = m_proxies.sync(scene, m_changed);
+        if (staticsChanged(scene, rebuilt))
+        {
+            rebuildStatics(scene);
+        }
+
+        if (rebuilt)
+        {
+            m_broadphase2D.beginSync();
+            m_broadphase3D.beginSync();
+            for (const ColliderProxy &proxy : m_proxies.proxies())
+            {
+                if (proxy.isStatic())
+                {
+                    continue;
+                }
+
+                if (proxy.is2D())
+                {
+                    m_broadphase2D.update(proxy.id, proxy.bounds2D(), proxy.layer, proxy.mask);
+                }
+                else
+                {
+                    m_broadphase3D.update(proxy.id, proxy.bounds, proxy.layer, proxy.mask);
+                }
+            }
+            m_broadphase2D.endSync();
+            m_broadphase3D.endSync();
+            m_snapshotStale = true;
+        }
+        else
+        {
+            // Only what moved or changed touches the hash and tree, and the snapshot stays valid
+            // unless a 2D entry did.
+            for (EntityId id : m_changed)
+            {
+                place(id);
+            }
+        }
+
+        m_syncedFrame = scene.frame();
+        m_synced = true;
+    }
+
+    void PhysicsWorld::syncIfStale(Scene &scene)
+    {
+        std::lock_guard<std::mutex> lock(m_syncMutex);
+        if (!m_synced || m_syncedFrame != scene.frame())
+        {
+            sync(scene);
+        }
+    }
+
+    void PhysicsWorld::refresh(const Entity &entity)
+    {
+        auto *scene = entity.scene();
+        if (scene && staticRevision(*scene) != m_staticRevision)
+        {
+            // A static body was added or removed; only a full pass finds it.
+            sync(*scene);
+            return;
+        }
+
+        m_proxies.update(entity);
+        const ColliderProxy *proxy = m_proxies.find(entity.id());
+        if (scene && proxy && proxy->isStatic())
+        {
+            rebuildStatics(*scene);
+        }
+
+        place(entity.id());
+    }
+
+    void PhysicsWorld::place(EntityId id)
+    {
+        // Only a change to the hash invalidates the 2D snapshot.
+        const ColliderProxy *proxy = m_proxies.find(id);
+        const bool dynamic = proxy && !proxy->isStatic();
+        if (dynamic && proxy->is2D())
+        {
+            m_broadphase2D.update(proxy->id, proxy->bounds2D(), proxy->layer, proxy->mask);
+            m_snapshotStale = true;
+        }
+        else if (m_broadphase2D.contains(id))
+        {
+            m_broadphase2D.remove(id);
+            m_snapshotStale = true;
+        }
+
+        if (dynamic && !proxy->is2D())
+        {
+            m_broadphase3D.update(proxy->id, proxy->bounds, proxy->layer, proxy->mask);
+        }
+        else
+        {
+            m_broadphase3D.remove(id);
+        }
+    }
+
+    const StaticBvh2D &PhysicsWorld::snapshot2D()
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        if (!m_snapshotStale)
+        {
+            return m_snapshot2D;
+        }
+
+        m_snapshotItems.clear();
+        m_broadphase2D.each(
+            [this](EntityId id, const Aabb2D &box, std::uint32_t layer, std::uint32_t mask)
+            {
+                m_snapshotItems.push_back({box, id, layer, mask});
+            });
+        m_snapshot2D.build(m_snapshotItems);
+        m_snapshotStale = false;
+        return m_snapshot2D;
+    }
+
+    bool PhysicsWorld::staticsChanged(Scene &scene, bool rebuilt) const
+    {
+        if (!m_staticsBuilt || staticRevision(scene) != m_staticRevision)
+        {
+            return true;
+        }
+
+        // A patch lists every proxy that differs from last frame, so a static that moved, resized
+        // or changed layers is among them; the baked set is only compared after a rebuild.
+        if (!rebuilt)
+        {
+            return std::any_of(m_changed.begin(), m_changed.end(),
+                               [this](EntityId id)
+                               {
+                                   const ColliderProxy *proxy = m_proxies.find(id);
+                                   return proxy && proxy->isStatic();
+                               });
+        }
+
+        // A static that gained its collider or shape since the bake is only in the proxy list, and
+        // the pools it touched are not in staticRevision(), so compare the sets, not just the baked side.
+        const auto &proxies = m_proxies.proxies();
+        const auto statics = std::count_if(proxies.begin(), proxies.end(),
+                                           [](const ColliderProxy &proxy)
+                                           {
+                                               return proxy.isStatic();
+                                           });
+        if (static_cast<std::size_t>(statics) != m_staticProxies.size())
+        {
+            return true;
+        }
+
+        // Same size and ids are unique, so every baked entry still present and static means the sets match.
+        for (const ColliderProxy &baked : m_staticProxies)
+        {
+            const ColliderProxy *proxy = m_proxies.find(baked.id);
+            if (!proxy || !proxy->isStatic() || proxy->is2D() != baked.is2D() || proxy->layer != baked.layer ||
+                proxy->mask != baked.mask || !sameBox(proxy->bounds, baked.bounds))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PhysicsWorld::rebuildStatics(Scene &scene)
+    {
+        std::vector<StaticBvh2D::Item> items2D;
+        std::vector<StaticBvh3D::Item> items3D;
+        m_staticProxies.clear();
+        for (const ColliderProxy &proxy : m_proxies.proxies())
+        {
+            if (!proxy.isStatic())
+            {
+                continue;
+            }
+
+            if (proxy.is2D())
+            {
+                items2D.push_back({proxy.bounds2D(), proxy.id, proxy.layer, proxy.mask});
+            }
+            else
+            {
+                items3D.push_back({proxy.bounds, proxy.id, proxy.layer, proxy.mask});
+            }
+            m_staticProxies.push_back(proxy);
+        }
+
+        m_statics2D.build(items2D);
+        m_statics3D.build(items3D);
+        m_staticRevision = staticRevision(scene);
+        m_staticsBuilt = true;
+    }
+}
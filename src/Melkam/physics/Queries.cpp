@@ -0,0 +1,336 @@
+#include <Melkam/physics/Queries.hpp>
+
+#include <Melkam/core/ThreadPool.hpp>
+#include <Melkam/physics/CollisionMesh.hpp>
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/physics/SweepBatch.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Per-thread candidate scratch, reused across casts.
+        thread_local SweepCandidates2D t_candidates2D;
+        thread_local SweepCandidates3D t_candidates3D;
+        thread_local std::vector<MeshCandidate> t_meshCandidates;
+
+        bool accepts(Scene &scene, const PhysicsWorld &world, const QueryFilter &filter, EntityId id)
+        {
+            return id != filter.exclude && scene.isValid(id) && (filter.hitTriggers || !world.isTrigger(id));
+        }
+
+        // 2D queries read the hash's BVH snapshot instead of the hash, whose queries are not
+        // safe to run concurrently.
+        template <typename Func>
+        void sweep2D(const PhysicsWorld &world, const StaticBvh2D &snapshot, const Aabb2D &box, const float motion[3],
+                     const QueryFilter &filter, Func &&func)
+        {
+            for (const StaticBvh2D *bvh : {&snapshot, &world.statics2D()})
+            {
+                bvh->sweepQuery(box, motion, filter.layer, filter.mask, [&](std::uint32_t index)
+                {
+                    const auto &item = bvh->item(index);
+                    func(item.id, item.box);
+                });
+            }
+        }
+
+        template <typename Func>
+        void sweep3D(PhysicsWorld &world, const Aabb3D &box, const float motion[3], const QueryFilter &filter, Func &&func)
+        {
+            world.broadphase3D().sweepQuery(box, motion, filter.layer, filter.mask, func);
+            world.statics3D().sweepQuery(box, motion, filter.layer, filter.mask, [&](std::uint32_t index)
+            {
+                const auto &item = world.statics3D().item(index);
+                func(item.id, item.box);
+            });
+        }
+
+        bool cast2D(Scene &scene, const PhysicsWorld &world, const StaticBvh2D &snapshot, const Aabb2D &box, const float motion[3],
+                    const QueryFilter &filter, QueryHit &outHit)
+        {
+            outHit = QueryHit{};
+            auto &candidates = t_candidates2D;
+            candidates.clear();
+            sweep2D(world, snapshot, box, motion, filter, [&](EntityId id, const Aabb2D &other)
+            {
+                if (accepts(scene, world, filter, id))
+                {
+                    candidates.push(id, other);
+                }
+            });
+
+            const SweepHit sweep = SweepAabbBatch(box, motion[0], motion[1], candidates);
+            if (!sweep.hit)
+            {
+                return false;
+            }
+
+            outHit.hit = true;
+            outHit.collider = candidates.ids[sweep.index];
+            outHit.point[0] = 0.5f * (box.minX + box.maxX) + motion[0] * sweep.time;
+            outHit.point[1] = 0.5f * (box.minY + box.maxY) + motion[1] * sweep.time;
+            outHit.normal[0] = sweep.normal[0];
+            outHit.normal[1] = sweep.normal[1];
+            outHit.fraction = sweep.time;
+            outHit.distance = sweep.time * std::sqrt(motion[0] * motion[0] + motion[1] * motion[1]);
+            return true;
+        }
+
+        bool cast3D(Scene &scene, PhysicsWorld &world, const Aabb3D &box, const float motion[3], const QueryFilter &filter, QueryHit &outHit)
+        {
+            outHit = QueryHit{};
+            auto &candidates = t_candidates3D;
+            auto &meshes = t_meshCandidates;
+            candidates.clear();
+            meshes.clear();
+            sweep3D(world, box, motion, filter, [&](EntityId id, const Aabb3D &other)
+            {
+                if (!accepts(scene, world, filter, id))
+                {
+                    return;
+                }
+                if (const MeshShape *shape = world.proxies().meshShape(id))
+                {
+                    meshes.push_back({id, shape->mesh, {shape->origin[0], shape->origin[1], shape->origin[2]}});
+                    return;
+                }
+                candidates.push(id, other);
+            });
+
+            SweepHit sweep = SweepAabbBatch(box, motion[0], motion[1], motion[2], candidates);
+            EntityId collider = sweep.hit ? candidates.ids[sweep.index] : InvalidEntity;
+            float depth = 0.0f;
+            if (!meshes.empty())
+            {
+                SweepMeshCandidates(box, motion, meshes, sweep, collider, depth);
+            }
+            if (!sweep.hit)
+            {
+                return false;
+            }
+
+            outHit.hit = true;
+            outHit.collider = collider;
+            outHit.point[0] = 0.5f * (box.minX + box.maxX) + motion[0] * sweep.time;
+            outHit.point[1] = 0.5f * (box.minY + box.maxY) + motion[1] * sweep.time;
+            outHit.point[2] = 0.5f * (box.minZ + box.maxZ) + motion[2] * sweep.time;
+            outHit.normal[0] = sweep.normal[0];
+            outHit.normal[1] = sweep.normal[1];
+            outHit.normal[2] = sweep.normal[2];
+            outHit.fraction = sweep.time;
+            outHit.distance = sweep.time * std::sqrt(motion[0] * motion[0] + motion[1] * motion[1] + motion[2] * motion[2]);
+            return true;
+        }
+
+        // A ray is a point box swept along direction * maxDistance.
+        bool castRay2D(Scene &scene, const PhysicsWorld &world, const StaticBvh2D &snapshot, const Ray2D &ray, const QueryFilter &filter,
+                       QueryHit &outHit)
+        {
+            const float length = std::sqrt(ray.direction[0] * ray.direction[0] + ray.direction[1] * ray.direction[1]);
+            if (length <= 0.0f || ray.maxDistance <= 0.0f)
+            {
+                outHit = QueryHit{};
+                return false;
+            }
+
+            const float scale = ray.maxDistance / length;
+            const float motion[3] = {ray.direction[0] * scale, ray.direction[1] * scale, 0.0f};
+            const Aabb2D point = {ray.origin[0], ray.origin[1], ray.origin[0], ray.origin[1]};
+            return cast2D(scene, world, snapshot, point, motion, filter, outHit);
+        }
+
+        bool castRay3D(Scene &scene, PhysicsWorld &world, const Ray3D &ray, const QueryFilter &filter, QueryHit &outHit)
+        {
+            const float length = std::sqrt(ray.direction[0] * ray.direction[0] + ray.direction[1] * ray.direction[1] +
+                                           ray.direction[2] * ray.direction[2]);
+            if (length <= 0.0f || ray.maxDistance <= 0.0f)
+            {
+                outHit = QueryHit{};
+                return false;
+            }
+
+            const float scale = ray.maxDistance / length;
+            const float motion[3] = {ray.direction[0] * scale, ray.direction[1] * scale, ray.direction[2] * scale};
+            const Aabb3D point = {ray.origin[0], ray.origin[1], ray.origin[2], ray.origin[0], ray.origin[1], ray.origin[2]};
+            return cast3D(scene, world, point, motion, filter, outHit);
+        }
+
+        // Runs cast(i) for i in [0, count) on the scene's thread pool in fixed chunks.
+        template <typename Cast>
+        void forEachRay(Scene &scene, std::size_t count, Cast &&cast)
+        {
+            constexpr std::size_t ChunkSize = 64;
+            ThreadPool *pool = scene.threadPool();
+            if (!pool || pool->workerCount() == 0 || count <= ChunkSize)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    cast(i);
+                }
+                return;
+            }
+
+            pool->parallelFor(count, ChunkSize,
+                              [&cast](std::size_t begin, std::size_t end)
+                              {
+                                  for (std::size_t i = begin; i < end; ++i)
+                                  {
+                                      cast(i);
+                                  }
+                              });
+        }
+
+        float distanceSquared(const Aabb2D &box, const float point[2])
+        {
+            const float dx = std::max({box.minX - point[0], 0.0f, point[0] - box.maxX});
+            const float dy = std::max({box.minY - point[1], 0.0f, point[1] - box.maxY});
+            return dx * dx + dy * dy;
+        }
+
+        float distanceSquared(const Aabb3D &box, const float point[3])
+        {
+            const float dx = std::max({box.minX - point[0], 0.0f, point[0] - box.maxX});
+            const float dy = std::max({box.minY - point[1], 0.0f, point[1] - box.maxY});
+            const float dz = std::max({box.minZ - point[2], 0.0f, point[2] - box.maxZ});
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        template <typename Test>
+        std::size_t overlap2D(Scene &scene, const Aabb2D &bounds, std::vector<EntityId> &outIds, const QueryFilter &filter, Test &&test)
+        {
+            outIds.clear();
+            auto &world = PhysicsWorld::get(scene);
+            world.syncIfStale(scene);
+            for (const StaticBvh2D *bvh : {&world.snapshot2D(), &world.statics2D()})
+            {
+                bvh->query(bounds, filter.layer, filter.mask, [&](std::uint32_t index)
+                {
+                    const auto &item = bvh->item(index);
+                    if (test(item.box) && accepts(scene, world, filter, item.id))
+                    {
+                        outIds.push_back(item.id);
+                    }
+                });
+            }
+
+            std::sort(outIds.begin(), outIds.end());
+            return outIds.size();
+        }
+
+        template <typename Test>
+        std::size_t overlap3D(Scene &scene, const Aabb3D &bounds, std::vector<EntityId> &outIds, const QueryFilter &filter, Test &&test)
+        {
+            outIds.clear();
+            auto &world = PhysicsWorld::get(scene);
+            world.syncIfStale(scene);
+            world.query3D(bounds, filter.layer, filter.mask, [&](EntityId id, const Aabb3D &box)
+            {
+                if (test(box) && accepts(scene, world, filter, id))
+                {
+                    outIds.push_back(id);
+                }
+            });
+
+            std::sort(outIds.begin(), outIds.end());
+            return outIds.size();
+        }
+    }
+
+    bool RayCast2D(Scene &scene, const Ray2D &ray, QueryHit &outHit, const QueryFilter &filter)
+    {
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        return castRay2D(scene, world, world.snapshot2D(), ray, filter, outHit);
+    }
+
+    bool RayCast3D(Scene &scene, const Ray3D &ray, QueryHit &outHit, const QueryFilter &filter)
+    {
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        return castRay3D(scene, world, ray, filter, outHit);
+    }
+
+    bool ShapeCast2D(Scene &scene, const Aabb2D &box, const float motion[2], QueryHit &outHit, const QueryFilter &filter)
+    {
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        const float motion3[3] = {motion[0], motion[1], 0.0f};
+        return cast2D(scene, world, world.snapshot2D(), box, motion3, filter, outHit);
+    }
+
+    bool ShapeCast3D(Scene &scene, const Aabb3D &box, const float motion[3], QueryHit &outHit, const QueryFilter &filter)
+    {
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        return cast3D(scene, world, box, motion, filter, outHit);
+    }
+
+    void RayCastBatch2D(Scene &scene, const std::vector<Ray2D> &rays, std::vector<QueryHit> &outHits, const QueryFilter &filter)
+    {
+        outHits.resize(rays.size());
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        const StaticBvh2D &snapshot = world.snapshot2D();
+        forEachRay(scene, rays.size(),
+                   [&](std::size_t i)
+                   {
+                       castRay2D(scene, world, snapshot, rays[i], filter, outHits[i]);
+                   });
+    }
+
+    void RayCastBatch3D(Scene &scene, const std::vector<Ray3D> &rays, std::vector<QueryHit> &outHits, const QueryFilter &filter)
+    {
+        outHits.resize(rays.size());
+        auto &world = PhysicsWorld::get(scene);
+        world.syncIfStale(scene);
+        forEachRay(scene, rays.size(),
+                   [&](std::size_t i)
+                   {
+                       castRay3D(scene, world, rays[i], filter, outHits[i]);
+                   });
+    }
+
+    std::size_t OverlapBox2D(Scene &scene, const Aabb2D &box, std::vector<EntityId> &outIds, const QueryFilter &filter)
+    {
+        return overlap2D(scene, box, outIds, filter,
+                         [&box](const Aabb2D &other)
+                         {
+                             return Intersects(box, other);
+                         });
+    }
+
+    std::size_t OverlapBox3D(Scene &scene, const Aabb3D &box, std::vector<EntityId> &outIds, const QueryFilter &filter)
+    {
+        return overlap3D(scene, box, outIds, filter,
+                         [&box](const Aabb3D &other)
+                         {
+                             return Intersects(box, other);
+                         });
+    }
+
+    std::size_t OverlapCircle2D(Scene &scene, const float center[2], float radius, std::vector<EntityId> &outIds, const QueryFilter &filter)
+    {
+        const Aabb2D bounds = {center[0] - radius, center[1] - radius, center[0] + radius, center[1] + radius};
+        return overlap2D(scene, bounds, outIds, filter,
+                         [center, radius](const Aabb2D &other)
+                         {
+                             return distanceSquared(other, center) < radius * radius;
+                         });
+    }
+
+    std::size_t OverlapSphere3D(Scene &scene, const float center[3], float radius, std::vector<EntityId> &outIds, const QueryFilter &filter)
+    {
+        const Aabb3D bounds = {center[0] - radius, center[1] - radius, center[2] - radius,
+                               center[0] + radius, center[1] + radius, center[2] + radius};
+        return overlap3D(scene, bounds, outIds, filter,
+                         [center, radius](const Aabb3D &other)
+                         {
+                             return distanceSquared(other, center) < radius * radius;
+                         });
+    }
+}
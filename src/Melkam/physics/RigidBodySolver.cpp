@@ -0,0 +1,657 @@
+#include <Melkam/physics/RigidBodySolver.hpp>
+
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace Melkam
+{
+    namespace
+    {
+        constexpr int axisCount(const Aabb2D &)
+        {
+            return 2;
+        }
+
+        constexpr int axisCount(const Aabb3D &)
+        {
+            return 3;
+        }
+
+        float lo(const Aabb2D &box, int axis)
+        {
+            return axis == 0 ? box.minX : box.minY;
+        }
+
+        float hi(const Aabb2D &box, int axis)
+        {
+            return axis == 0 ? box.maxX : box.maxY;
+        }
+
+        float lo(const Aabb3D &box, int axis)
+        {
+            return axis == 0 ? box.minX : axis == 1 ? box.minY : box.minZ;
+        }
+
+        float hi(const Aabb3D &box, int axis)
+        {
+            return axis == 0 ? box.maxX : axis == 1 ? box.maxY : box.maxZ;
+        }
+
+        Aabb2D grow(const Aabb2D &box, const float margin[3])
+        {
+            return {box.minX - margin[0], box.minY - margin[1], box.maxX + margin[0], box.maxY + margin[1]};
+        }
+
+        Aabb3D grow(const Aabb3D &box, const float margin[3])
+        {
+            return {box.minX - margin[0], box.minY - margin[1], box.minZ - margin[2],
+                    box.maxX + margin[0], box.maxY + margin[1], box.maxZ + margin[2]};
+        }
+
+        bool computeBox(const Entity &entity, const TransformComponent &transform, Aabb2D &out)
+        {
+            return ComputeAabb2D(entity, transform, out);
+        }
+
+        bool computeBox(const Entity &entity, const TransformComponent &transform, Aabb3D &out)
+        {
+            return ComputeAabb3D(entity, transform, out);
+        }
+
+        template <typename Func>
+        void queryWorld(PhysicsWorld &world, const Aabb2D &box, std::uint32_t layer, std::uint32_t mask, Func &&func)
+        {
+            world.query2D(box, layer, mask, func);
+        }
+
+        template <typename Func>
+        void queryWorld(PhysicsWorld &world, const Aabb3D &box, std::uint32_t layer, std::uint32_t mask, Func &&func)
+        {
+            world.query3D(box, layer, mask, func);
+        }
+
+        // k-th axis perpendicular to `axis`.
+        int tangentAxis(int axis, int k, int axes)
+        {
+            return (axis + 1 + k) % axes;
+        }
+    }
+
+    template <typename Box>
+    RigidBodySolver<Box>::RigidBodySolver()
+    {
+        if constexpr (std::is_same_v<Box, Aabb2D>)
+        {
+            m_settings = Settings{{0.0f, 980.0f, 0.0f}, 0.5f, 5.0f};
+        }
+        else
+        {
+            m_settings = Settings{{0.0f, -9.81f, 0.0f}, 0.005f, 0.05f};
+        }
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::step(Scene &scene, PhysicsWorld &world, float dt)
+    {
+        if (dt <= 0.0f)
+        {
+            return;
+        }
+
+        wakeUnsupported(scene);
+        gather(scene);
+
+        const int axes = axisCount(Box{});
+        for (Body &body : m_bodies)
+        {
+            if (body.invMass > 0.0f)
+            {
+                for (int axis = 0; axis < axes; ++axis)
+                {
+                    body.v[axis] += m_settings.gravity[axis] * dt;
+                }
+            }
+        }
+
+        findContacts(scene, world, dt);
+        solve(dt);
+
+        for (Body &body : m_bodies)
+        {
+            body.transform->position.x += body.v[0] * dt;
+            body.transform->position.y += body.v[1] * dt;
+            if (axes == 3)
+            {
+                body.transform->position.z += body.v[2] * dt;
+            }
+        }
+
+        updateSleep(dt);
+
+        for (const Body &body : m_bodies)
+        {
+            for (int axis = 0; axis < axes; ++axis)
+            {
+                body.velocity[axis] = body.v[axis];
+            }
+            world.refresh(Entity(&scene, body.id));
+        }
+
+        m_cache.swap(m_contacts);
+
+        // Sleepers touched this step join the next one; until then they held still.
+        std::sort(m_pendingWakes.begin(), m_pendingWakes.end());
+        m_pendingWakes.erase(std::unique(m_pendingWakes.begin(), m_pendingWakes.end()), m_pendingWakes.end());
+        for (std::uint32_t island : m_pendingWakes)
+        {
+            wakeIsland(island);
+        }
+        m_pendingWakes.clear();
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::wake(EntityId id)
+    {
+        const BodyState *entry = findState(id);
+        if (entry && entry->island != 0u)
+        {
+            wakeIsland(entry->island);
+        }
+    }
+
+    template <typename Box>
+    bool RigidBodySolver<Box>::isSleeping(EntityId id) const
+    {
+        const BodyState *entry = findState(id);
+        return entry && entry->island != 0u;
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::clear()
+    {
+        m_states.clear();
+        m_bodies.clear();
+        m_contacts.clear();
+        m_cache.clear();
+        m_islands.clear();
+        m_pendingWakes.clear();
+        m_nextIsland = 1;
+        m_colliderRevision = 0;
+    }
+
+    template <typename Box>
+    typename RigidBodySolver<Box>::BodyState &RigidBodySolver<Box>::state(EntityId id)
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_states.size())
+        {
+            m_states.resize(slot + 1);
+        }
+
+        BodyState &entry = m_states[slot];
+        if (entry.id != id)
+        {
+            // New body, or the slot was reused by a newer entity version.
+            entry = BodyState{};
+            entry.id = id;
+        }
+        return entry;
+    }
+
+    template <typename Box>
+    const typename RigidBodySolver<Box>::BodyState *RigidBodySolver<Box>::findState(EntityId id) const
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        return slot < m_states.size() && m_states[slot].id == id ? &m_states[slot] : nullptr;
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::gather(Scene &scene)
+    {
+        for (const Body &body : m_bodies)
+        {
+            BodyState &entry = m_states[EntityIndex(body.id)];
+            if (entry.id == body.id)
+            {
+                entry.body = NoBody;
+            }
+        }
+        m_bodies.clear();
+
+        constexpr bool is2D = std::is_same_v<Box, Aabb2D>;
+        if constexpr (is2D)
+        {
+            scene.view<RigidBody2DComponent, TransformComponent, ColliderComponent>().each(
+                [this](Entity entity, RigidBody2DComponent &rigid, TransformComponent &transform, ColliderComponent &collider)
+                {
+                    if (collider.is2D)
+                    {
+                        addBody(entity, transform, rigid.velocity, rigid.mass, rigid.isKinematic);
+                    }
+                });
+        }
+        else
+        {
+            scene.view<RigidBody3DComponent, TransformComponent, ColliderComponent>().each(
+                [this](Entity entity, RigidBody3DComponent &rigid, TransformComponent &transform, ColliderComponent &collider)
+                {
+                    if (!collider.is2D)
+                    {
+                        addBody(entity, transform, rigid.velocity, rigid.mass, rigid.isKinematic);
+                    }
+                });
+        }
+
+        // The generic component follows the collider's dimension; RigidBody2D/3D win when both are present.
+        scene.view<RigidBodyComponent, TransformComponent, ColliderComponent>().each(
+            [this](Entity entity, RigidBodyComponent &rigid, TransformComponent &transform, ColliderComponent &collider)
+            {
+                if (collider.is2D == is2D && !entity.hasComponent<RigidBody2DComponent>() && !entity.hasComponent<RigidBody3DComponent>())
+                {
+                    addBody(entity, transform, rigid.velocity, rigid.mass, rigid.isKinematic);
+                }
+            });
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::addBody(Entity &entity, TransformComponent &transform, float *velocity, float mass, bool kinematic)
+    {
+        if (IsStaticBody(entity) || IsTriggerLike(entity, entity.tryGetComponent<ColliderComponent>()))
+        {
+            return;
+        }
+
+        const int axes = axisCount(Box{});
+        BodyState &entry = state(entity.id());
+        if (entry.island != 0u)
+        {
+            // Asleep unless someone set a velocity. Island members already passed this step
+            // join the next one.
+            bool pushed = false;
+            for (int axis = 0; axis < axes; ++axis)
+            {
+                pushed = pushed || velocity[axis] != 0.0f;
+            }
+            if (!pushed)
+            {
+                return;
+            }
+            wakeIsland(entry.island);
+        }
+
+        Body body{};
+        if (!computeBox(entity, transform, body.box))
+        {
+            return;
+        }
+
+        const auto *layers = entity.tryGetComponent<CollisionLayerComponent>();
+        body.id = entity.id();
+        body.transform = &transform;
+        body.previous = entity.tryGetComponent<PreviousTransformComponent>();
+        if (body.previous)
+        {
+            body.previous->position = transform.position;
+            body.previous->rotation = transform.rotation;
+            body.previous->captured = true;
+        }
+        body.velocity = velocity;
+        for (int axis = 0; axis < axes; ++axis)
+        {
+            body.v[axis] = velocity[axis];
+        }
+        body.invMass = kinematic || mass <= 0.0f ? 0.0f : 1.0f / mass;
+        body.layer = LayerBits(layers);
+        body.mask = MaskBits(layers);
+        body.parent = static_cast<std::uint32_t>(m_bodies.size());
+
+        entry.body = body.parent;
+        m_bodies.push_back(body);
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::wakeIsland(std::uint32_t island)
+    {
+        const auto it = m_islands.find(island);
+        if (it == m_islands.end())
+        {
+            return;
+        }
+
+        for (EntityId id : it->second.bodies)
+        {
+            const std::uint32_t slot = EntityIndex(id);
+            if (slot < m_states.size() && m_states[slot].id == id)
+            {
+                m_states[slot].island = 0u;
+                m_states[slot].sleepTime = 0.0f;
+            }
+        }
+        m_islands.erase(it);
+    }
+
+    // Islands only need checking when colliders were added or removed somewhere in the scene.
+    template <typename Box>
+    void RigidBodySolver<Box>::wakeUnsupported(Scene &scene)
+    {
+        const std::uint64_t revision = scene.revision<ColliderComponent>();
+        if (revision == m_colliderRevision)
+        {
+            return;
+        }
+        m_colliderRevision = revision;
+
+        const auto gone = [&scene](EntityId id)
+        {
+            return !scene.isValid(id) || !scene.hasComponent<ColliderComponent>(id);
+        };
+
+        std::vector<std::uint32_t> lost;
+        for (const auto &[island, sleeping] : m_islands)
+        {
+            if (std::any_of(sleeping.supports.begin(), sleeping.supports.end(), gone) ||
+                std::any_of(sleeping.bodies.begin(), sleeping.bodies.end(), gone))
+            {
+                lost.push_back(island);
+            }
+        }
+
+        for (std::uint32_t island : lost)
+        {
+            wakeIsland(island);
+        }
+    }
+
+    template <typename Box>
+    bool RigidBodySolver<Box>::touchedLastStep(EntityId idA, EntityId idB) const
+    {
+        Contact key{};
+        key.idA = idA;
+        key.idB = idB;
+        return std::binary_search(m_cache.begin(), m_cache.end(), key);
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::findContacts(Scene &scene, PhysicsWorld &world, float dt)
+    {
+        const int axes = axisCount(Box{});
+        const float sleepSpeed2 = m_settings.sleepSpeed * m_settings.sleepSpeed;
+        m_contacts.clear();
+
+        for (std::uint32_t i = 0; i < m_bodies.size(); ++i)
+        {
+            const Body &body = m_bodies[i];
+            float margin[3] = {0.0f, 0.0f, 0.0f};
+            float speed2 = 0.0f;
+            for (int axis = 0; axis < axes; ++axis)
+            {
+                margin[axis] = std::abs(body.v[axis]) * dt + m_settings.slop;
+                // Last step's velocity, before this step's gravity.
+                speed2 += body.velocity[axis] * body.velocity[axis];
+            }
+
+            // A resting body or an idle kinematic one holds sleepers up like a static collider
+            // does; only motion or a fresh contact wakes them. Kinematic bodies never get a
+            // contact against a sleeper, so for them only motion counts.
+            const bool moving = body.invMass == 0.0f ? speed2 > 0.0f : speed2 > sleepSpeed2;
+
+            queryWorld(world, grow(body.box, margin), body.layer, body.mask,
+                       [&](EntityId otherId, const Box &otherBox)
+                       {
+                           if (otherId == body.id || world.isTrigger(otherId) || !scene.isValid(otherId))
+                           {
+                               return;
+                           }
+
+                           const BodyState *other = findState(otherId);
+                           if (other && other->island != 0u && (moving || (body.invMass > 0.0f && !touchedLastStep(body.id, otherId))))
+                           {
+                               m_pendingWakes.push_back(other->island);
+                           }
+
+                           const std::uint32_t j = other ? other->body : NoBody;
+                           if (body.invMass == 0.0f && (j == NoBody || m_bodies[j].invMass == 0.0f))
+                           {
+                               return;
+                           }
+
+                           // Body pairs are keyed (lower id, higher id) and found from both
+                           // sides; fixed colliders are always B.
+                           Contact contact{};
+                           const bool swap = j != NoBody && m_bodies[j].id < body.id;
+                           contact.a = swap ? j : i;
+                           contact.b = swap ? i : j;
+                           contact.idA = swap ? otherId : body.id;
+                           contact.idB = swap ? body.id : otherId;
+
+                           const Box &boxA = m_bodies[contact.a].box;
+                           const Box &boxB = contact.b != NoBody ? m_bodies[contact.b].box : otherBox;
+                           float best = std::numeric_limits<float>::max();
+                           for (int axis = 0; axis < axes; ++axis)
+                           {
+                               const float overlap = std::min(hi(boxA, axis), hi(boxB, axis)) - std::max(lo(boxA, axis), lo(boxB, axis));
+                               if (overlap < best)
+                               {
+                                   best = overlap;
+                                   contact.axis = axis;
+                               }
+                           }
+
+                           contact.separation = -best;
+                           contact.sign = lo(boxB, contact.axis) + hi(boxB, contact.axis) >= lo(boxA, contact.axis) + hi(boxA, contact.axis) ? 1.0f : -1.0f;
+                           m_contacts.push_back(contact);
+                       });
+        }
+
+        std::sort(m_contacts.begin(), m_contacts.end());
+        m_contacts.erase(std::unique(m_contacts.begin(), m_contacts.end(),
+                                     [](const Contact &a, const Contact &b)
+                                     {
+                                         return a.idA == b.idA && a.idB == b.idB;
+                                     }),
+                         m_contacts.end());
+
+        // Both lists are sorted by pair, so the warm start is a merge walk.
+        std::size_t cached = 0;
+        for (Contact &contact : m_contacts)
+        {
+            while (cached < m_cache.size() && m_cache[cached] < contact)
+            {
+                ++cached;
+            }
+
+            if (cached < m_cache.size() && !(contact < m_cache[cached]) && m_cache[cached].axis == contact.axis && m_cache[cached].sign == contact.sign)
+            {
+                contact.normalImpulse = m_cache[cached].normalImpulse;
+                contact.tangentImpulse[0] = m_cache[cached].tangentImpulse[0];
+                contact.tangentImpulse[1] = m_cache[cached].tangentImpulse[1];
+            }
+        }
+    }
+
+    template <typename Box>
+    void RigidBodySolver<Box>::solve(float dt)
+    {
+        const int axes = axisCount(Box{});
+        const float fixedVelocity[3] = {0.0f, 0.0f, 0.0f};
+
+        for (Contact &contact : m_contacts)
+        {
+            Body &a = m_bodies[contact.a];
+            Body *b = contact.b != NoBody ? &m_bodies[contact.b] : nullptr;
+            const float *vb = b ? b->v : fixedVelocity;
+            const float invMassB = b ? b->invMass : 0.0f;
+            contact.normalMass = 1.0f / (a.invMass + invMassB);
+
+            // Speculative when apart: the pair may close the gap this step but not more.
+            const float approach = (vb[contact.axis] - a.v[contact.axis]) * contact.sign;
+            if (contact.separation > 0.0f)
+            {
+                contact.bias = contact.separation / dt;
+            }
+            else
+            {
+                contact.bias = -m_settings.baumgarte / dt * std::max(-contact.separation - m_settings.slop, 0.0f);
+                if (approach < 0.0f)
+                {
+                    contact.bias = std::min(contact.bias, m_settings.restitution * approach);
+                }
+            }
+
+            const float normal = contact.normalImpulse * contact.sign;
+            a.v[contact.axis] -= a.invMass * normal;
+            if (b)
+            {
+                b->v[contact.axis] += b->invMass * normal;
+            }
+            for (int k = 0; k < axes - 1; ++k)
+            {
+                const int axis = tangentAxis(contact.axis, k, axes);
+                a.v[axis] -= a.invMass * contact.tangentImpulse[k];
+                if (b)
+                {
+                    b->v[axis] += b->invMass * contact.tangentImpulse[k];
+                }
+            }
+        }
+
+        for (int iteration = 0; iteration < m_settings.iterations; ++iteration)
+        {
+            for (Contact &contact : m_contacts)
+            {
+                Body &a = m_bodies[contact.a];
+                Body *b = contact.b != NoBody ? &m_bodies[contact.b] : nullptr;
+                const float *vb = b ? b->v : fixedVelocity;
+
+                const float maxFriction = m_settings.friction * contact.normalImpulse;
+                for (int k = 0; k < axes - 1; ++k)
+                {
+                    const int axis = tangentAxis(contact.axis, k, axes);
+                    const float previous = contact.tangentImpulse[k];
+                    contact.tangentImpulse[k] = std::clamp(previous - contact.normalMass * (vb[axis] - a.v[axis]), -maxFriction, maxFriction);
+                    const float impulse = contact.tangentImpulse[k] - previous;
+                    a.v[axis] -= a.invMass * impulse;
+                    if (b)
+                    {
+                        b->v[axis] += b->invMass * impulse;
+                    }
+                }
+
+                const float approach = (vb[contact.axis] - a.v[contact.axis]) * contact.sign;
+                const float previous = contact.normalImpulse;
+                contact.normalImpulse = std::max(previous - contact.normalMass * (approach + contact.bias), 0.0f);
+                const float impulse = (contact.normalImpulse - previous) * contact.sign;
+                a.v[contact.axis] -= a.invMass * impulse;
+                if (b)
+                {
+                    b->v[contact.axis] += b->invMass * impulse;
+                }
+            }
+        }
+    }
+
+    template <typename Box>
+    std::uint32_t RigidBodySolver<Box>::findRoot(std::uint32_t body)
+    {
+        while (m_bodies[body].parent != body)
+        {
+            m_bodies[body].parent = m_bodies[m_bodies[body].parent].parent;
+            body = m_bodies[body].parent;
+        }
+        return body;
+    }
+
+    // Islands are rebuilt from this step's contacts; kinematic bodies and fixed colliders do
+    // not join them, so a pile resting on the ground is not linked to every other pile.
+    template <typename Box>
+    void RigidBodySolver<Box>::updateSleep(float dt)
+    {
+        const int axes = axisCount(Box{});
+        for (const Contact &contact : m_contacts)
+        {
+            if (contact.b != NoBody && m_bodies[contact.a].invMass > 0.0f && m_bodies[contact.b].invMass > 0.0f)
+            {
+                const std::uint32_t rootA = findRoot(contact.a);
+                const std::uint32_t rootB = findRoot(contact.b);
+                // The lower index becomes the root so the result does not depend on contact order.
+                m_bodies[std::max(rootA, rootB)].parent = std::min(rootA, rootB);
+            }
+        }
+
+        const float sleepSpeed2 = m_settings.sleepSpeed * m_settings.sleepSpeed;
+        std::vector<float> islandSleep(m_bodies.size(), std::numeric_limits<float>::max());
+        for (std::uint32_t i = 0; i < m_bodies.size(); ++i)
+        {
+            const Body &body = m_bodies[i];
+            if (body.invMass == 0.0f)
+            {
+                continue;
+            }
+
+            float speed2 = 0.0f;
+            for (int axis = 0; axis < axes; ++axis)
+            {
+                speed2 += body.v[axis] * body.v[axis];
+            }
+
+            BodyState &entry = m_states[EntityIndex(body.id)];
+            entry.sleepTime = speed2 > sleepSpeed2 ? 0.0f : entry.sleepTime + dt;
+            float &sleep = islandSleep[findRoot(i)];
+            sleep = std::min(sleep, entry.sleepTime);
+        }
+
+        std::vector<std::uint32_t> islandIds(m_bodies.size(), 0u);
+        for (std::uint32_t i = 0; i < m_bodies.size(); ++i)
+        {
+            Body &body = m_bodies[i];
+            const std::uint32_t root = findRoot(i);
+            if (body.invMass == 0.0f || islandSleep[root] < m_settings.timeToSleep)
+            {
+                continue;
+            }
+
+            if (islandIds[root] == 0u)
+            {
+                islandIds[root] = m_nextIsland;
+                m_nextIsland = m_nextIsland == 0xFFFFFFFFu ? 1u : m_nextIsland + 1;
+            }
+
+            m_islands[islandIds[root]].bodies.push_back(body.id);
+            m_states[EntityIndex(body.id)].island = islandIds[root];
+            for (int axis = 0; axis < axes; ++axis)
+            {
+                body.v[axis] = 0.0f;
+            }
+            if (body.previous)
+            {
+                // Nothing captures a sleeper's transform, so rendering must not keep blending.
+                body.previous->position = body.transform->position;
+            }
+        }
+
+        // Whatever a sleeping island rests on, so removing it wakes the island.
+        for (const Contact &contact : m_contacts)
+        {
+            const Body &a = m_bodies[contact.a];
+            const bool fixedB = contact.b == NoBody || m_bodies[contact.b].invMass == 0.0f;
+            if (a.invMass > 0.0f && fixedB && islandIds[findRoot(contact.a)] != 0u)
+            {
+                m_islands[islandIds[findRoot(contact.a)]].supports.push_back(contact.idB);
+            }
+            else if (a.invMass == 0.0f && !fixedB && islandIds[findRoot(contact.b)] != 0u)
+            {
+                m_islands[islandIds[findRoot(contact.b)]].supports.push_back(contact.idA);
+            }
+        }
+    }
+
+    template class RigidBodySolver<Aabb2D>;
+    template class RigidBodySolver<Aabb3D>;
+}
@@ -0,0 +1,229 @@
+#include <Melkam/physics/SpatialHash2D.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Keeps cell coordinates (and CellRange::count) well inside int32 for far-away or
+        // non-finite boxes.
+        constexpr float CellLimit = 1048576.0f;
+    }
+
+    SpatialHash2D::SpatialHash2D(float cellSize)
+    {
+        setCellSize(cellSize);
+    }
+
+    void SpatialHash2D::setCellSize(float cellSize)
+    {
+        m_cellSize = std::max(0.001f, cellSize);
+        m_inverseCellSize = 1.0f / m_cellSize;
+
+        m_cells.clear();
+        m_oversized.clear();
+        for (std::uint32_t i = 0; i < m_proxies.size(); ++i)
+        {
+            if (m_proxies[i].id != InvalidEntity)
+            {
+                m_proxies[i].cells = cellRange(m_proxies[i].box);
+                link(i);
+            }
+        }
+    }
+
+    void SpatialHash2D::update(EntityId id, const Aabb2D &box, std::uint32_t layer, std::uint32_t mask)
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size())
+        {
+            m_lookup.resize(slot + 1, 0);
+        }
+
+        std::uint32_t index = m_lookup[slot];
+        if (index != 0 && m_proxies[index - 1].id != id)
+        {
+            // Slot reused by a newer entity version; drop the stale proxy.
+            unlink(index - 1);
+            m_proxies[index - 1].id = InvalidEntity;
+            m_freeProxies.push_back(index - 1);
+            --m_count;
+            index = 0;
+        }
+
+        if (index == 0)
+        {
+            if (!m_freeProxies.empty())
+            {
+                index = m_freeProxies.back() + 1;
+                m_freeProxies.pop_back();
+            }
+            else
+            {
+                m_proxies.emplace_back();
+                index = static_cast<std::uint32_t>(m_proxies.size());
+            }
+
+            Proxy &proxy = m_proxies[index - 1];
+            proxy = Proxy{};
+            proxy.id = id;
+            proxy.box = box;
+            proxy.layer = layer;
+            proxy.mask = mask;
+            proxy.cells = cellRange(box);
+            proxy.sync = m_sync;
+            m_lookup[slot] = index;
+            ++m_count;
+            link(index - 1);
+            return;
+        }
+
+        Proxy &proxy = m_proxies[index - 1];
+        proxy.box = box;
+        proxy.layer = layer;
+        proxy.mask = mask;
+        proxy.sync = m_sync;
+
+        const CellRange cells = cellRange(box);
+        if (!(cells == proxy.cells))
+        {
+            unlink(index - 1);
+            proxy.cells = cells;
+            link(index - 1);
+        }
+    }
+
+    void SpatialHash2D::remove(EntityId id)
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size() || m_lookup[slot] == 0)
+        {
+            return;
+        }
+
+        const std::uint32_t index = m_lookup[slot] - 1;
+        if (m_proxies[index].id != id)
+        {
+            return;
+        }
+
+        unlink(index);
+        m_proxies[index].id = InvalidEntity;
+        m_freeProxies.push_back(index);
+        m_lookup[slot] = 0;
+        --m_count;
+    }
+
+    bool SpatialHash2D::contains(EntityId id) const
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        return slot < m_lookup.size() && m_lookup[slot] != 0 && m_proxies[m_lookup[slot] - 1].id == id;
+    }
+
+    void SpatialHash2D::clear()
+    {
+        m_proxies.clear();
+        m_freeProxies.clear();
+        m_lookup.clear();
+        m_cells.clear();
+        m_oversized.clear();
+        m_count = 0;
+    }
+
+    void SpatialHash2D::beginSync()
+    {
+        ++m_sync;
+    }
+
+    void SpatialHash2D::endSync()
+    {
+        for (const Proxy &proxy : m_proxies)
+        {
+            if (proxy.id != InvalidEntity && proxy.sync != m_sync)
+            {
+                remove(proxy.id);
+            }
+        }
+    }
+
+    SpatialHash2D::CellRange SpatialHash2D::cellRange(const Aabb2D &box) const
+    {
+        return {cellCoord(box.minX), cellCoord(box.minY), cellCoord(box.maxX), cellCoord(box.maxY)};
+    }
+
+    std::int32_t SpatialHash2D::cellCoord(float value) const
+    {
+        const float cell = std::floor(value * m_inverseCellSize);
+        if (!(cell > -CellLimit))
+        {
+            return static_cast<std::int32_t>(-CellLimit);
+        }
+        return static_cast<std::int32_t>(std::min(cell, CellLimit));
+    }
+
+    void SpatialHash2D::link(std::uint32_t index)
+    {
+        Proxy &proxy = m_proxies[index];
+        proxy.oversized = proxy.cells.count() > MaxCellsPerProxy;
+        if (proxy.oversized)
+        {
+            m_oversized.push_back(index);
+            return;
+        }
+
+        for (std::int32_t y = proxy.cells.minY; y <= proxy.cells.maxY; ++y)
+        {
+            for (std::int32_t x = proxy.cells.minX; x <= proxy.cells.maxX; ++x)
+            {
+                m_cells[cellKey(x, y)].push_back(index);
+            }
+        }
+    }
+
+    void SpatialHash2D::unlink(std::uint32_t index)
+    {
+        auto erase = [index](std::vector<std::uint32_t> &list)
+        {
+            const auto it = std::find(list.begin(), list.end(), index);
+            if (it != list.end())
+            {
+                *it = list.back();
+                list.pop_back();
+            }
+        };
+
+        const Proxy &proxy = m_proxies[index];
+        if (proxy.oversized)
+        {
+            erase(m_oversized);
+            return;
+        }
+
+        for (std::int32_t y = proxy.cells.minY; y <= proxy.cells.maxY; ++y)
+        {
+            for (std::int32_t x = proxy.cells.minX; x <= proxy.cells.maxX; ++x)
+            {
+                const auto it = m_cells.find(cellKey(x, y));
+                if (it != m_cells.end())
+                {
+                    erase(it->second);
+                }
+            }
+        }
+    }
+
+    std::uint32_t SpatialHash2D::nextVisit()
+    {
+        if (++m_visit == 0)
+        {
+            for (Proxy &proxy : m_proxies)
+            {
+                proxy.visit = 0;
+            }
+            m_visit = 1;
+        }
+        return m_visit;
+    }
+}
@@ -0,0 +1,138 @@
+#include <Melkam/physics/StaticBvh.hpp>
+
+#include <algorithm>
+
+namespace Melkam
+{
+    namespace
+    {
+        constexpr int axisCount(const Aabb2D &)
+        {
+            return 2;
+        }
+
+        constexpr int axisCount(const Aabb3D &)
+        {
+            return 3;
+        }
+
+        Aabb2D merge(const Aabb2D &a, const Aabb2D &b)
+        {
+            return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+        }
+
+        Aabb3D merge(const Aabb3D &a, const Aabb3D &b)
+        {
+            return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::min(a.minZ, b.minZ),
+                    std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY), std::max(a.maxZ, b.maxZ)};
+        }
+
+        void center(const Aabb2D &box, float out[3])
+        {
+            out[0] = 0.5f * (box.minX + box.maxX);
+            out[1] = 0.5f * (box.minY + box.maxY);
+            out[2] = 0.0f;
+        }
+
+        void center(const Aabb3D &box, float out[3])
+        {
+            out[0] = 0.5f * (box.minX + box.maxX);
+            out[1] = 0.5f * (box.minY + box.maxY);
+            out[2] = 0.5f * (box.minZ + box.maxZ);
+        }
+    }
+
+    template <typename Box>
+    void StaticBvh<Box>::build(const std::vector<Item> &items)
+    {
+        clear();
+        if (items.empty())
+        {
+            return;
+        }
+
+        std::vector<BuildEntry> entries(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            entries[i].index = static_cast<std::uint32_t>(i);
+            center(items[i].box, entries[i].center);
+        }
+
+        // A binary tree with LeafSize-item leaves has fewer than 2 * n / LeafSize + 1 nodes.
+        m_nodes.reserve(2 * items.size() / LeafSize + 1);
+        m_items.reserve(items.size());
+        m_order.reserve(items.size());
+        m_slots.resize(items.size());
+        buildRange(items, entries, 0, entries.size());
+    }
+
+    template <typename Box>
+    void StaticBvh<Box>::clear()
+    {
+        m_nodes.clear();
+        m_items.clear();
+        m_order.clear();
+        m_slots.clear();
+    }
+
+    template <typename Box>
+    void StaticBvh<Box>::buildRange(const std::vector<Item> &items, std::vector<BuildEntry> &entries, std::size_t begin, std::size_t end)
+    {
+        const std::uint32_t nodeIndex = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        Box box = items[entries[begin].index].box;
+        std::uint32_t layers = 0u;
+        float lo[3] = {entries[begin].center[0], entries[begin].center[1], entries[begin].center[2]};
+        float hi[3] = {lo[0], lo[1], lo[2]};
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const Item &item = items[entries[i].index];
+            box = merge(box, item.box);
+            layers |= item.layer;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                lo[axis] = std::min(lo[axis], entries[i].center[axis]);
+                hi[axis] = std::max(hi[axis], entries[i].center[axis]);
+            }
+        }
+
+        if (end - begin <= LeafSize)
+        {
+            const std::uint32_t first = static_cast<std::uint32_t>(m_items.size());
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                m_slots[entries[i].index] = static_cast<std::uint32_t>(m_items.size());
+                m_items.push_back(items[entries[i].index]);
+                m_order.push_back(entries[i].index);
+            }
+
+            m_nodes[nodeIndex] = {box, first, static_cast<std::uint32_t>(end - begin), nodeIndex + 1, layers};
+            return;
+        }
+
+        // Median split on the axis where the centres spread furthest.
+        int axis = 0;
+        for (int candidate = 1; candidate < axisCount(box); ++candidate)
+        {
+            if (hi[candidate] - lo[candidate] > hi[axis] - lo[axis])
+            {
+                axis = candidate;
+            }
+        }
+
+        const std::size_t middle = begin + (end - begin) / 2;
+        std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end,
+                         [axis](const BuildEntry &a, const BuildEntry &b)
+                         {
+                             return a.center[axis] < b.center[axis] || (a.center[axis] == b.center[axis] && a.index < b.index);
+                         });
+
+        buildRange(items, entries, begin, middle);
+        buildRange(items, entries, middle, end);
+        m_nodes[nodeIndex] = {box, 0u, 0u, static_cast<std::uint32_t>(m_nodes.size()), layers};
+    }
+
+    template class StaticBvh<Aabb2D>;
+    template class StaticBvh<Aabb3D>;
+}
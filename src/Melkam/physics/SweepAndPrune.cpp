@@ -0,0 +1,297 @@
+#include <Melkam/physics/SweepAndPrune.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Melkam
+{
+    namespace
+    {
+        // Min endpoints sort first on ties, so a zero-width box opens before it closes. Boxes that
+        // only touch are then active together; the strict Intersects test rejects them.
+        template <typename Endpoint>
+        bool endpointLess(const Endpoint &a, const Endpoint &b)
+        {
+            if (a.value != b.value)
+            {
+                return a.value < b.value;
+            }
+            return a.isMax() != b.isMax() ? b.isMax() : a.data < b.data;
+        }
+
+        // A NaN endpoint never sorts consistently, so such boxes are kept out of the sweep.
+        bool hasNaN(const Aabb2D &box)
+        {
+            return std::isnan(box.minX) || std::isnan(box.minY) || std::isnan(box.maxX) || std::isnan(box.maxY);
+        }
+
+        bool hasNaN(const Aabb3D &box)
+        {
+            return std::isnan(box.minX) || std::isnan(box.minY) || std::isnan(box.minZ) || std::isnan(box.maxX) ||
+                   std::isnan(box.maxY) || std::isnan(box.maxZ);
+        }
+
+        // An inverted box would close before it opens.
+        void order(Aabb2D &box)
+        {
+            if (box.minX > box.maxX)
+            {
+                std::swap(box.minX, box.maxX);
+            }
+            if (box.minY > box.maxY)
+            {
+                std::swap(box.minY, box.maxY);
+            }
+        }
+
+        void order(Aabb3D &box)
+        {
+            if (box.minX > box.maxX)
+            {
+                std::swap(box.minX, box.maxX);
+            }
+            if (box.minY > box.maxY)
+            {
+                std::swap(box.minY, box.maxY);
+            }
+            if (box.minZ > box.maxZ)
+            {
+                std::swap(box.minZ, box.maxZ);
+            }
+        }
+    }
+
+    template <typename Box>
+    void SweepAndPrune<Box>::update(EntityId id, const Box &box, std::uint32_t layer, std::uint32_t mask, bool sensor)
+    {
+        if (hasNaN(box))
+        {
+            remove(id);
+            return;
+        }
+
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size())
+        {
+            m_lookup.resize(slot + 1, 0u);
+        }
+
+        std::uint32_t index = m_lookup[slot];
+        if (index != 0u && m_proxies[index - 1].id != id)
+        {
+            // Slot reused by a newer entity version; retire the stale proxy.
+            remove(m_proxies[index - 1].id);
+            index = 0u;
+        }
+
+        if (index == 0u)
+        {
+            if (!m_freeProxies.empty())
+            {
+                index = m_freeProxies.back() + 1;
+                m_freeProxies.pop_back();
+            }
+            else
+            {
+                m_proxies.emplace_back();
+                index = static_cast<std::uint32_t>(m_proxies.size());
+            }
+
+            // Appended endpoints are unsorted; the next sweep's insertion sort moves them into place.
+            const std::uint32_t proxy = index - 1;
+            m_endpoints.push_back({0.0f, proxy << 1});
+            m_endpoints.push_back({0.0f, (proxy << 1) | 1u});
+            m_lookup[slot] = index;
+            m_proxies[proxy] = Proxy{};
+            m_proxies[proxy].live = true;
+            ++m_count;
+        }
+
+        Proxy &proxy = m_proxies[index - 1];
+        proxy.box = box;
+        order(proxy.box);
+        proxy.id = id;
+        proxy.layer = layer;
+        proxy.mask = mask;
+        proxy.sensor = sensor;
+        proxy.sync = m_sync;
+    }
+
+    template <typename Box>
+    void SweepAndPrune<Box>::remove(EntityId id)
+    {
+        const std::uint32_t index = findProxy(id);
+        if (index == 0u)
+        {
+            return;
+        }
+
+        m_proxies[index - 1].live = false;
+        m_lookup[EntityIndex(id)] = 0u;
+        m_hasDead = true;
+        --m_count;
+    }
+
+    template <typename Box>
+    bool SweepAndPrune<Box>::contains(EntityId id) const
+    {
+        return findProxy(id) != 0u;
+    }
+
+    template <typename Box>
+    bool SweepAndPrune<Box>::isSensor(EntityId id) const
+    {
+        const std::uint32_t index = findProxy(id);
+        return index != 0u && m_proxies[index - 1].sensor;
+    }
+
+    template <typename Box>
+    void SweepAndPrune<Box>::clear()
+    {
+        m_proxies.clear();
+        m_freeProxies.clear();
+        m_lookup.clear();
+        m_endpoints.clear();
+        m_pairs.clear();
+        m_count = 0;
+        m_hasDead = false;
+    }
+
+    template <typename Box>
+    void SweepAndPrune<Box>::beginSync()
+    {
+        ++m_sync;
+    }
+
+    template <typename Box>
+    void SweepAndPrune<Box>::endSync()
+    {
+        for (const Proxy &proxy : m_proxies)
+        {
+            if (proxy.live && proxy.sync != m_sync)
+            {
+                remove(proxy.id);
+            }
+        }
+    }
+
+    template <typename Box>
+    const std::vector<typename SweepAndPrune<Box>::Pair> &SweepAndPrune<Box>::sweep()
+    {
+        if (m_hasDead)
+        {
+            compactEndpoints();
+        }
+
+        for (Endpoint &endpoint : m_endpoints)
+        {
+            const Box &box = m_proxies[endpoint.proxy()].box;
+            endpoint.value = endpoint.isMax() ? box.maxX : box.minX;
+        }
+
+        for (std::size_t i = 1; i < m_endpoints.size(); ++i)
+        {
+            const Endpoint endpoint = m_endpoints[i];
+            std::size_t j = i;
+            while (j > 0 && endpointLess(endpoint, m_endpoints[j - 1]))
+            {
+                m_endpoints[j] = m_endpoints[j - 1];
+                --j;
+            }
+            m_endpoints[j] = endpoint;
+        }
+
+        m_pairs.clear();
+        m_activeSensors.clear();
+        m_activeBodies.clear();
+        for (const Endpoint &endpoint : m_endpoints)
+        {
+            const std::uint32_t index = endpoint.proxy();
+            Proxy &proxy = m_proxies[index];
+            auto &own = proxy.sensor ? m_activeSensors : m_activeBodies;
+
+            if (endpoint.isMax())
+            {
+                // update() keeps boxes ordered, but a close without its open must not pop.
+                if (proxy.active == NotActive)
+                {
+                    continue;
+                }
+
+                const std::uint32_t last = own.back();
+                own[proxy.active] = last;
+                m_proxies[last].active = proxy.active;
+                own.pop_back();
+                proxy.active = NotActive;
+                continue;
+            }
+
+            for (std::uint32_t otherIndex : proxy.sensor ? m_activeBodies : m_activeSensors)
+            {
+                const Proxy &other = m_proxies[otherIndex];
+                if (!LayersCollide(proxy.layer, proxy.mask, other.layer, other.mask) || !Intersects(proxy.box, other.box))
+                {
+                    continue;
+                }
+
+                m_pairs.push_back(proxy.sensor ? Pair{proxy.id, other.id} : Pair{other.id, proxy.id});
+            }
+
+            proxy.active = static_cast<std::uint32_t>(own.size());
+            own.push_back(index);
+        }
+
+        for (std::uint32_t index : m_activeSensors)
+        {
+            m_proxies[index].active = NotActive;
+        }
+        for (std::uint32_t index : m_activeBodies)
+        {
+            m_proxies[index].active = NotActive;
+        }
+
+        std::sort(m_pairs.begin(), m_pairs.end());
+        return m_pairs;
+    }
+
+    template <typename Box>
+    std::uint32_t SweepAndPrune<Box>::findProxy(EntityId id) const
+    {
+        const std::uint32_t slot = EntityIndex(id);
+        if (slot >= m_lookup.size())
+        {
+            return 0u;
+        }
+
+        const std::uint32_t index = m_lookup[slot];
+        return index != 0u && m_proxies[index - 1].id == id ? index : 0u;
+    }
+
+    // Drops dead proxies' endpoints, keeping the rest in order, and only then frees their slots
+    // so a reused slot never inherits stale endpoints.
+    template <typename Box>
+    void SweepAndPrune<Box>::compactEndpoints()
+    {
+        m_endpoints.erase(std::remove_if(m_endpoints.begin(), m_endpoints.end(),
+                                         [this](const Endpoint &endpoint)
+                                         {
+                                             return !m_proxies[endpoint.proxy()].live;
+                                         }),
+                          m_endpoints.end());
+
+        for (std::uint32_t i = 0; i < m_proxies.size(); ++i)
+        {
+            Proxy &proxy = m_proxies[i];
+            if (!proxy.live && proxy.id != InvalidEntity)
+            {
+                proxy = Proxy{};
+                m_freeProxies.push_back(i);
+            }
+        }
+        m_hasDead = false;
+    }
+
+    template class SweepAndPrune<Aabb2D>;
+    template class SweepAndPrune<Aabb3D>;
+}
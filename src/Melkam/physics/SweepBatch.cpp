@@ -0,0 +1,569 @@
+#include <Melkam/physics/SweepBatch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(MELKAM_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MELKAM_SIMD_SSE4)
+#include <smmintrin.h>
+#endif
+
+// The vector paths repeat the scalar sweep operation for operation (the build passes
+// -ffp-contract=off), so a lane's time of impact is bit-identical to sweepAabb2D/3D's. Normals
+// are only needed for the winner and come from the scalar sweep.
+
+namespace Melkam
+{
+    namespace
+    {
+        bool overlapNormal2D(const Aabb2D &a, const Aabb2D &b, float &outNx, float &outNy)
+        {
+            if (!Intersects(a, b))
+            {
+                return false;
+            }
+
+            const float overlapX1 = b.maxX - a.minX;
+            const float overlapX2 = a.maxX - b.minX;
+            const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
+
+            const float overlapY1 = b.maxY - a.minY;
+            const float overlapY2 = a.maxY - b.minY;
+            const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
+
+            if (std::abs(resolveX) < std::abs(resolveY))
+            {
+                outNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
+                outNy = 0.0f;
+            }
+            else
+            {
+                outNx = 0.0f;
+                outNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
+            }
+            return true;
+        }
+
+        bool overlapNormal3D(const Aabb3D &a, const Aabb3D &b, float &outNx, float &outNy, float &outNz)
+        {
+            if (!Intersects(a, b))
+            {
+                return false;
+            }
+
+            const float overlapX1 = b.maxX - a.minX;
+            const float overlapX2 = a.maxX - b.minX;
+            const float resolveX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
+
+            const float overlapY1 = b.maxY - a.minY;
+            const float overlapY2 = a.maxY - b.minY;
+            const float resolveY = (overlapY1 < overlapY2) ? -overlapY1 : overlapY2;
+
+            const float overlapZ1 = b.maxZ - a.minZ;
+            const float overlapZ2 = a.maxZ - b.minZ;
+            const float resolveZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
+
+            float absX = std::abs(resolveX);
+            float absY = std::abs(resolveY);
+            float absZ = std::abs(resolveZ);
+
+            if (absX <= absY && absX <= absZ)
+            {
+                outNx = (resolveX < 0.0f) ? -1.0f : 1.0f;
+                outNy = 0.0f;
+                outNz = 0.0f;
+            }
+            else if (absY <= absX && absY <= absZ)
+            {
+                outNx = 0.0f;
+                outNy = (resolveY < 0.0f) ? -1.0f : 1.0f;
+                outNz = 0.0f;
+            }
+            else
+            {
+                outNx = 0.0f;
+                outNy = 0.0f;
+                outNz = (resolveZ < 0.0f) ? -1.0f : 1.0f;
+            }
+            return true;
+        }
+
+        bool sweepAabb2D(const Aabb2D &mover, const Aabb2D &target, float dx, float dy, float &outTime, float &outNx, float &outNy)
+        {
+            const float inf = std::numeric_limits<float>::infinity();
+            if (dx == 0.0f && dy == 0.0f)
+            {
+                return false;
+            }
+
+            if (dx == 0.0f && (mover.maxX <= target.minX || mover.minX >= target.maxX))
+            {
+                return false;
+            }
+
+            if (dy == 0.0f && (mover.maxY <= target.minY || mover.minY >= target.maxY))
+            {
+                return false;
+            }
+
+            if (overlapNormal2D(mover, target, outNx, outNy))
+            {
+                outTime = 0.0f;
+                return true;
+            }
+
+            float xInvEntry;
+            float xInvExit;
+            float yInvEntry;
+            float yInvExit;
+
+            if (dx > 0.0f)
+            {
+                xInvEntry = target.minX - mover.maxX;
+                xInvExit = target.maxX - mover.minX;
+            }
+            else
+            {
+                xInvEntry = target.maxX - mover.minX;
+                xInvExit = target.minX - mover.maxX;
+            }
+
+            if (dy > 0.0f)
+            {
+                yInvEntry = target.minY - mover.maxY;
+                yInvExit = target.maxY - mover.minY;
+            }
+            else
+            {
+                yInvEntry = target.maxY - mover.minY;
+                yInvExit = target.minY - mover.maxY;
+            }
+
+            const float xEntry = (dx == 0.0f) ? -inf : xInvEntry / dx;
+            const float xExit = (dx == 0.0f) ? inf : xInvExit / dx;
+            const float yEntry = (dy == 0.0f) ? -inf : yInvEntry / dy;
+            const float yExit = (dy == 0.0f) ? inf : yInvExit / dy;
+
+            const float entryTime = std::max(xEntry, yEntry);
+            const float exitTime = std::min(xExit, yExit);
+
+            if (entryTime > exitTime || entryTime > 1.0f || entryTime < 0.0f)
+            {
+                return false;
+            }
+
+            if (xEntry > yEntry)
+            {
+                outNx = (dx > 0.0f) ? -1.0f : 1.0f;
+                outNy = 0.0f;
+            }
+            else
+            {
+                outNx = 0.0f;
+                outNy = (dy > 0.0f) ? -1.0f : 1.0f;
+            }
+
+            outTime = entryTime;
+            return true;
+        }
+
+        bool sweepAabb3D(const Aabb3D &mover, const Aabb3D &target, float dx, float dy, float dz, float &outTime, float &outNx, float &outNy, float &outNz)
+        {
+            const float inf = std::numeric_limits<float>::infinity();
+            if (dx == 0.0f && dy == 0.0f && dz == 0.0f)
+            {
+                return false;
+            }
+
+            if (dx == 0.0f && (mover.maxX <= target.minX || mover.minX >= target.maxX))
+            {
+                return false;
+            }
+
+            if (dy == 0.0f && (mover.maxY <= target.minY || mover.minY >= target.maxY))
+            {
+                return false;
+            }
+
+            if (dz == 0.0f && (mover.maxZ <= target.minZ || mover.minZ >= target.maxZ))
+            {
+                return false;
+            }
+
+            if (overlapNormal3D(mover, target, outNx, outNy, outNz))
+            {
+                outTime = 0.0f;
+                return true;
+            }
+
+            float xInvEntry;
+            float xInvExit;
+            float yInvEntry;
+            float yInvExit;
+            float zInvEntry;
+            float zInvExit;
+
+            if (dx > 0.0f)
+            {
+                xInvEntry = target.minX - mover.maxX;
+                xInvExit = target.maxX - mover.minX;
+            }
+            else
+            {
+                xInvEntry = target.maxX - mover.minX;
+                xInvExit = target.minX - mover.maxX;
+            }
+
+            if (dy > 0.0f)
+            {
+                yInvEntry = target.minY - mover.maxY;
+                yInvExit = target.maxY - mover.minY;
+            }
+            else
+            {
+                yInvEntry = target.maxY - mover.minY;
+                yInvExit = target.minY - mover.maxY;
+            }
+
+            if (dz > 0.0f)
+            {
+                zInvEntry = target.minZ - mover.maxZ;
+                zInvExit = target.maxZ - mover.minZ;
+            }
+            else
+            {
+                zInvEntry = target.maxZ - mover.minZ;
+                zInvExit = target.minZ - mover.maxZ;
+            }
+
+            const float xEntry = (dx == 0.0f) ? -inf : xInvEntry / dx;
+            const float xExit = (dx == 0.0f) ? inf : xInvExit / dx;
+            const float yEntry = (dy == 0.0f) ? -inf : yInvEntry / dy;
+            const float yExit = (dy == 0.0f) ? inf : yInvExit / dy;
+            const float zEntry = (dz == 0.0f) ? -inf : zInvEntry / dz;
+            const float zExit = (dz == 0.0f) ? inf : zInvExit / dz;
+
+            const float entryTime = std::max(xEntry, std::max(yEntry, zEntry));
+            const float exitTime = std::min(xExit, std::min(yExit, zExit));
+
+            if (entryTime > exitTime || entryTime > 1.0f || entryTime < 0.0f)
+            {
+                return false;
+            }
+
+            if (xEntry >= yEntry && xEntry >= zEntry)
+            {
+                outNx = (dx > 0.0f) ? -1.0f : 1.0f;
+                outNy = 0.0f;
+                outNz = 0.0f;
+            }
+            else if (yEntry >= xEntry && yEntry >= zEntry)
+            {
+                outNx = 0.0f;
+                outNy = (dy > 0.0f) ? -1.0f : 1.0f;
+                outNz = 0.0f;
+            }
+            else
+            {
+                outNx = 0.0f;
+                outNy = 0.0f;
+                outNz = (dz > 0.0f) ? -1.0f : 1.0f;
+            }
+
+            outTime = entryTime;
+            return true;
+        }
+
+#if defined(MELKAM_SIMD_AVX2) || defined(MELKAM_SIMD_SSE4)
+        // One kernel body for both vector widths. vmax(a, b) is a > b ? a : b and vmin(a, b) is
+        // a < b ? a : b, so std::max(x, y) is vmax(y, x) and std::min(x, y) is vmin(y, x).
+#if defined(MELKAM_SIMD_AVX2)
+        using Vec = __m256;
+        constexpr std::size_t Lanes = 8;
+
+        inline Vec load(const float *p) { return _mm256_loadu_ps(p); }
+        inline void store(float *p, Vec v) { _mm256_storeu_ps(p, v); }
+        inline Vec splat(float v) { return _mm256_set1_ps(v); }
+        inline Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+        inline Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+        inline Vec vmax(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+        inline Vec vmin(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+        inline Vec lt(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        inline Vec le(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        inline Vec gt(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        inline Vec ge(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        inline Vec both(Vec a, Vec b) { return _mm256_and_ps(a, b); }
+        inline Vec either(Vec a, Vec b) { return _mm256_or_ps(a, b); }
+        inline Vec unless(Vec mask, Vec v) { return _mm256_andnot_ps(mask, v); }
+        inline Vec select(Vec mask, Vec a, Vec b) { return _mm256_blendv_ps(b, a, mask); }
+        inline int bits(Vec mask) { return _mm256_movemask_ps(mask); }
+#else
+        using Vec = __m128;
+        constexpr std::size_t Lanes = 4;
+
+        inline Vec load(const float *p) { return _mm_loadu_ps(p); }
+        inline void store(float *p, Vec v) { _mm_storeu_ps(p, v); }
+        inline Vec splat(float v) { return _mm_set1_ps(v); }
+        inline Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+        inline Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+        inline Vec vmax(Vec a, Vec b) { return _mm_max_ps(a, b); }
+        inline Vec vmin(Vec a, Vec b) { return _mm_min_ps(a, b); }
+        inline Vec lt(Vec a, Vec b) { return _mm_cmplt_ps(a, b); }
+        inline Vec le(Vec a, Vec b) { return _mm_cmple_ps(a, b); }
+        inline Vec gt(Vec a, Vec b) { return _mm_cmpgt_ps(a, b); }
+        inline Vec ge(Vec a, Vec b) { return _mm_cmpge_ps(a, b); }
+        inline Vec both(Vec a, Vec b) { return _mm_and_ps(a, b); }
+        inline Vec either(Vec a, Vec b) { return _mm_or_ps(a, b); }
+        inline Vec unless(Vec mask, Vec v) { return _mm_andnot_ps(mask, v); }
+        inline Vec select(Vec mask, Vec a, Vec b) { return _mm_blendv_ps(b, a, mask); }
+        inline int bits(Vec mask) { return _mm_movemask_ps(mask); }
+#endif
+
+        // Entry and exit times along one axis for every lane, matching the scalar sweep: the
+        // near face depends only on the sign of the motion, which is the same for all lanes.
+        struct AxisTimes
+        {
+            Vec entry;
+            Vec exit;
+        };
+
+        inline AxisTimes axisTimes(Vec moverMin, Vec moverMax, Vec targetMin, Vec targetMax, float delta)
+        {
+            const float inf = std::numeric_limits<float>::infinity();
+            if (delta == 0.0f)
+            {
+                return {splat(-inf), splat(inf)};
+            }
+
+            const Vec d = splat(delta);
+            const Vec towardMin = div(sub(targetMin, moverMax), d);
+            const Vec towardMax = div(sub(targetMax, moverMin), d);
+            return delta > 0.0f ? AxisTimes{towardMin, towardMax} : AxisTimes{towardMax, towardMin};
+        }
+
+        // Lanes with no motion on an axis miss when they are apart on it, before any overlap test.
+        inline Vec separated(Vec moverMin, Vec moverMax, Vec targetMin, Vec targetMax, float delta)
+        {
+            return delta == 0.0f ? either(le(moverMax, targetMin), ge(moverMin, targetMax)) : splat(0.0f);
+        }
+
+        inline Vec overlapping(Vec moverMin, Vec moverMax, Vec targetMin, Vec targetMax)
+        {
+            return both(lt(moverMin, targetMax), gt(moverMax, targetMin));
+        }
+
+        // Time of impact for lanes in mask: 0 where the boxes already overlap, the entry time otherwise.
+        template <typename Consider>
+        void considerLanes(Vec mask, Vec overlap, Vec entry, std::size_t base, Consider &&consider)
+        {
+            const int laneBits = bits(mask);
+            if (laneBits == 0)
+            {
+                return;
+            }
+
+            float times[Lanes];
+            store(times, select(overlap, splat(0.0f), entry));
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                if ((laneBits & (1 << lane)) != 0)
+                {
+                    consider(base + lane, times[lane]);
+                }
+            }
+        }
+#endif
+    }
+
+    void SweepCandidates2D::clear()
+    {
+        ids.clear();
+        minX.clear();
+        minY.clear();
+        maxX.clear();
+        maxY.clear();
+    }
+
+    void SweepCandidates2D::push(EntityId id, const Aabb2D &box)
+    {
+        ids.push_back(id);
+        minX.push_back(box.minX);
+        minY.push_back(box.minY);
+        maxX.push_back(box.maxX);
+        maxY.push_back(box.maxY);
+    }
+
+    Aabb2D SweepCandidates2D::box(std::size_t index) const
+    {
+        return {minX[index], minY[index], maxX[index], maxY[index]};
+    }
+
+    void SweepCandidates3D::clear()
+    {
+        ids.clear();
+        minX.clear();
+        minY.clear();
+        minZ.clear();
+        maxX.clear();
+        maxY.clear();
+        maxZ.clear();
+    }
+
+    void SweepCandidates3D::push(EntityId id, const Aabb3D &box)
+    {
+        ids.push_back(id);
+        minX.push_back(box.minX);
+        minY.push_back(box.minY);
+        minZ.push_back(box.minZ);
+        maxX.push_back(box.maxX);
+        maxY.push_back(box.maxY);
+        maxZ.push_back(box.maxZ);
+    }
+
+    Aabb3D SweepCandidates3D::box(std::size_t index) const
+    {
+        return {minX[index], minY[index], minZ[index], maxX[index], maxY[index], maxZ[index]};
+    }
+
+    SweepHit SweepAabbBatch(const Aabb2D &mover, float dx, float dy, const SweepCandidates2D &candidates)
+    {
+        SweepHit result;
+        const std::size_t count = candidates.size();
+        if (count == 0 || (dx == 0.0f && dy == 0.0f))
+        {
+            return result;
+        }
+
+        EntityId bestId = InvalidEntity;
+        auto consider = [&](std::size_t index, float time)
+        {
+            if (time < result.time || (time == result.time && result.hit && candidates.ids[index] < bestId))
+            {
+                result.hit = true;
+                result.index = index;
+                result.time = time;
+                bestId = candidates.ids[index];
+            }
+        };
+
+        std::size_t i = 0;
+#if defined(MELKAM_SIMD_AVX2) || defined(MELKAM_SIMD_SSE4)
+        const Vec moverMinX = splat(mover.minX);
+        const Vec moverMinY = splat(mover.minY);
+        const Vec moverMaxX = splat(mover.maxX);
+        const Vec moverMaxY = splat(mover.maxY);
+        const Vec zero = splat(0.0f);
+        const Vec one = splat(1.0f);
+        for (; i + Lanes <= count; i += Lanes)
+        {
+            const Vec minX = load(candidates.minX.data() + i);
+            const Vec minY = load(candidates.minY.data() + i);
+            const Vec maxX = load(candidates.maxX.data() + i);
+            const Vec maxY = load(candidates.maxY.data() + i);
+
+            const AxisTimes x = axisTimes(moverMinX, moverMaxX, minX, maxX, dx);
+            const AxisTimes y = axisTimes(moverMinY, moverMaxY, minY, maxY, dy);
+            const Vec entry = vmax(y.entry, x.entry);
+            const Vec exit = vmin(y.exit, x.exit);
+
+            const Vec overlap = both(overlapping(moverMinX, moverMaxX, minX, maxX), overlapping(moverMinY, moverMaxY, minY, maxY));
+            const Vec swept = both(both(le(entry, exit), lt(entry, one)), ge(entry, zero));
+            const Vec apart = either(separated(moverMinX, moverMaxX, minX, maxX, dx), separated(moverMinY, moverMaxY, minY, maxY, dy));
+            considerLanes(unless(apart, either(overlap, swept)), overlap, entry, i, consider);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            float time = 0.0f;
+            float nx = 0.0f;
+            float ny = 0.0f;
+            if (sweepAabb2D(mover, candidates.box(i), dx, dy, time, nx, ny))
+            {
+                consider(i, time);
+            }
+        }
+
+        if (result.hit)
+        {
+            float time = 0.0f;
+            sweepAabb2D(mover, candidates.box(result.index), dx, dy, time, result.normal[0], result.normal[1]);
+        }
+        return result;
+    }
+
+    SweepHit SweepAabbBatch(const Aabb3D &mover, float dx, float dy, float dz, const SweepCandidates3D &candidates)
+    {
+        SweepHit result;
+        const std::size_t count = candidates.size();
+        if (count == 0 || (dx == 0.0f && dy == 0.0f && dz == 0.0f))
+        {
+            return result;
+        }
+
+        EntityId bestId = InvalidEntity;
+        auto consider = [&](std::size_t index, float time)
+        {
+            if (time < result.time || (time == result.time && result.hit && candidates.ids[index] < bestId))
+            {
+                result.hit = true;
+                result.index = index;
+                result.time = time;
+                bestId = candidates.ids[index];
+            }
+        };
+
+        std::size_t i = 0;
+#if defined(MELKAM_SIMD_AVX2) || defined(MELKAM_SIMD_SSE4)
+        const Vec moverMinX = splat(mover.minX);
+        const Vec moverMinY = splat(mover.minY);
+        const Vec moverMinZ = splat(mover.minZ);
+        const Vec moverMaxX = splat(mover.maxX);
+        const Vec moverMaxY = splat(mover.maxY);
+        const Vec moverMaxZ = splat(mover.maxZ);
+        const Vec zero = splat(0.0f);
+        const Vec one = splat(1.0f);
+        for (; i + Lanes <= count; i += Lanes)
+        {
+            const Vec minX = load(candidates.minX.data() + i);
+            const Vec minY = load(candidates.minY.data() + i);
+            const Vec minZ = load(candidates.minZ.data() + i);
+            const Vec maxX = load(candidates.maxX.data() + i);
+            const Vec maxY = load(candidates.maxY.data() + i);
+            const Vec maxZ = load(candidates.maxZ.data() + i);
+
+            const AxisTimes x = axisTimes(moverMinX, moverMaxX, minX, maxX, dx);
+            const AxisTimes y = axisTimes(moverMinY, moverMaxY, minY, maxY, dy);
+            const AxisTimes z = axisTimes(moverMinZ, moverMaxZ, minZ, maxZ, dz);
+            const Vec entry = vmax(vmax(z.entry, y.entry), x.entry);
+            const Vec exit = vmin(vmin(z.exit, y.exit), x.exit);
+
+            const Vec overlap = both(both(overlapping(moverMinX, moverMaxX, minX, maxX), overlapping(moverMinY, moverMaxY, minY, maxY)),
+                                     overlapping(moverMinZ, moverMaxZ, minZ, maxZ));
+            const Vec swept = both(both(le(entry, exit), lt(entry, one)), ge(entry, zero));
+            const Vec apart = either(either(separated(moverMinX, moverMaxX, minX, maxX, dx), separated(moverMinY, moverMaxY, minY, maxY, dy)),
+                                     separated(moverMinZ, moverMaxZ, minZ, maxZ, dz));
+            considerLanes(unless(apart, either(overlap, swept)), overlap, entry, i, consider);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            float time = 0.0f;
+            float nx = 0.0f;
+            float ny = 0.0f;
+            float nz = 0.0f;
+            if (sweepAabb3D(mover, candidates.box(i), dx, dy, dz, time, nx, ny, nz))
+            {
+                consider(i, time);
+            }
+        }
+
+        if (result.hit)
+        {
+            float time = 0.0f;
+            sweepAabb3D(mover, candidates.box(result.index), dx, dy, dz, time, result.normal[0], result.normal[1], result.normal[2]);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,130 @@
+#include <Melkam/scene/CommandBuffer.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+namespace Melkam
+{
+    CommandBuffer::CommandBuffer(Scene &scene) : m_scene(scene)
+    {
+    }
+
+    EntityId CommandBuffer::createEntity(const std::string &name, EntityId parent)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_creates.push_back(name);
+
+        // Placeholders carry version 0, which no live entity ever has; the index is 1 + the create slot.
+        const EntityId id = MakeEntityId(static_cast<std::uint32_t>(m_creates.size()), 0u);
+        if (parent != InvalidEntity)
+        {
+            m_parents.push_back({id, parent});
+        }
+        return id;
+    }
+
+    void CommandBuffer::destroyEntity(EntityId id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_destroys.push_back(id);
+    }
+
+    void CommandBuffer::setParent(EntityId child, EntityId parent)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_parents.push_back({child, parent});
+    }
+
+    bool CommandBuffer::empty() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_creates.empty() || !m_parents.empty() || !m_destroys.empty())
+        {
+            return false;
+        }
+
+        for (const auto &queue : m_queues)
+        {
+            if (queue && !queue->empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CommandBuffer::flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_created.clear();
+        m_created.reserve(m_creates.size());
+        for (const auto &name : m_creates)
+        {
+            m_created.push_back(m_scene.createEntity(name).id());
+        }
+
+        for (auto &queue : m_queues)
+        {
+            if (queue)
+            {
+                queue->applyAdds(*this);
+            }
+        }
+
+        for (const auto &command : m_parents)
+        {
+            const EntityId parent = resolve(command.parent);
+            m_scene.setParent(Entity(&m_scene, resolve(command.child)), Entity(&m_scene, parent));
+        }
+
+        for (auto &queue : m_queues)
+        {
+            if (queue)
+            {
+                queue->applyRemoves(*this);
+            }
+        }
+
+        for (auto &id : m_destroys)
+        {
+            id = resolve(id);
+        }
+        m_scene.destroyEntities(m_destroys);
+
+        m_creates.clear();
+        m_created.clear();
+        m_parents.clear();
+        m_destroys.clear();
+    }
+
+    void CommandBuffer::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_creates.clear();
+        m_created.clear();
+        m_parents.clear();
+        m_destroys.clear();
+        for (auto &queue : m_queues)
+        {
+            if (queue)
+            {
+                queue->clear();
+            }
+        }
+    }
+
+    bool CommandBuffer::isPlaceholder(EntityId id)
+    {
+        return id != InvalidEntity && EntityVersion(id) == 0u;
+    }
+
+    EntityId CommandBuffer::resolve(EntityId id) const
+    {
+        if (!isPlaceholder(id))
+        {
+            return id;
+        }
+
+        const std::size_t slot = EntityIndex(id) - 1u;
+        return slot < m_created.size() ? m_created[slot] : InvalidEntity;
+    }
+}
@@ -4,7 +4,17 @@
 
 namespace Melkam
 {
-    Scene::Scene(std::string name) : m_name(std::move(name))
+    namespace
+    {
+        constexpr std::uint32_t NoWorldParent = 0xFFFFFFFFu;
+
+        bool sameVector(const Vector3f &a, const Vector3f &b)
+        {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+    }
+
+    Scene::Scene(std::string name) : m_name(std::move(name)), m_commands(*this)
     {
     }
 
@@ -17,13 +27,25 @@ namespace Melkam
 
     Entity Scene::createEntity(const std::string &name)
     {
-        EntityId id = ++m_nextId;
-        m_entities.push_back(id);
-        m_entitySet.insert(id);
+        EntityId id = InvalidEntity;
+        if (!m_freeSlots.empty())
+        {
+            const std::uint32_t index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            id = MakeEntityId(index, m_versions[index]);
+        }
+        else
+        {
+            const auto index = static_cast<std::uint32_t>(m_versions.size());
+            m_versions.push_back(1u);
+            id = MakeEntityId(index, 1u);
+        }
 
         addComponent<NameComponent>(id, NameComponent{name});
         addComponent<NodeComponent>(id, NodeComponent{});
         addComponent<TransformComponent>(id, TransformComponent{});
+        addComponent<WorldTransformComponent>(id, WorldTransformComponent{});
+        ++m_hierarchyVersion;
 
         return Entity(this, id);
     }
@@ -43,36 +65,50 @@ namespace Melkam
         }
 
         const EntityId id = entity.id();
-        auto *node = tryGetComponent<NodeComponent>(id);
-        if (node)
+        unlinkNode(id);
+        ++m_hierarchyVersion;
+
+        for (auto &storage : m_components)
         {
-            if (node->parent != InvalidEntity)
+            if (storage)
             {
-                auto *parentNode = tryGetComponent<NodeComponent>(node->parent);
-                if (parentNode)
-                {
-                    auto &siblings = parentNode->children;
-                    siblings.erase(std::remove(siblings.begin(), siblings.end(), id), siblings.end());
-                }
+                storage->remove(id);
             }
+        }
+
+        releaseSlot(EntityIndex(id));
+    }
+
+    void Scene::destroyEntities(std::vector<EntityId> ids)
+    {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        ids.erase(std::remove_if(ids.begin(), ids.end(), [this](EntityId id)
+                                 { return !isValid(id); }),
+                  ids.end());
+        if (ids.empty())
+        {
+            return;
+        }
+
+        for (EntityId id : ids)
+        {
+            unlinkNode(id);
+        }
+        ++m_hierarchyVersion;
 
-            for (EntityId childId : node->children)
+        for (auto &storage : m_components)
+        {
+            if (storage)
             {
-                auto *childNode = tryGetComponent<NodeComponent>(childId);
-                if (childNode)
-                {
-                    childNode->parent = InvalidEntity;
-                }
+                storage->removeMany(ids);
             }
         }
 
-        for (auto &pair : m_components)
+        for (EntityId id : ids)
         {
-            pair.second->remove(id);
+            releaseSlot(EntityIndex(id));
         }
-
-        m_entitySet.erase(id);
-        m_entities.erase(std::remove(m_entities.begin(), m_entities.end(), id), m_entities.end());
     }
 
     void Scene::setParent(Entity child, Entity parent)
@@ -112,6 +148,7 @@ namespace Melkam
         }
 
         childNode->parent = parentId;
+        ++m_hierarchyVersion;
 
         if (parentId != InvalidEntity)
         {
@@ -126,12 +163,19 @@ namespace Melkam
     std::vector<Entity> Scene::rootEntities() const
     {
         std::vector<Entity> roots;
-        for (EntityId id : m_entities)
+        const auto *nodes = findStorage<NodeComponent>();
+        if (!nodes)
         {
-            const auto *node = tryGetComponent<NodeComponent>(id);
-            if (node && node->parent == InvalidEntity)
+            return roots;
+        }
+
+        const auto &ids = nodes->entities();
+        const NodeComponent *data = nodes->data();
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            if (data[i].parent == InvalidEntity)
             {
-                roots.emplace_back(const_cast<Scene *>(this), id);
+                roots.emplace_back(const_cast<Scene *>(this), ids[i]);
             }
         }
         return roots;
@@ -139,38 +183,114 @@ namespace Melkam
 
     void Scene::update(float dt)
     {
-        for (auto &system : m_systems)
+        ++m_frame;
+        if (m_scheduler.dirty())
         {
-            system->onUpdate(*this, dt);
+            prepareSchedule();
         }
 
-        traverse(
-            [this, dt](Entity &entity)
+        updateWorldTransforms();
+        m_scheduler.run(*this, m_systems, m_threadPool, dt);
+
+        // Only walk the hierarchy for systems that actually implement a per-entity hook.
+        auto pre = [this, dt](Entity &entity)
+        {
+            for (System *system : m_preUpdateSystems)
             {
-                for (auto &system : m_systems)
-                {
-                    system->onPreUpdate(*this, entity, dt);
-                }
-            },
-            [this, dt](Entity &entity)
+                system->onPreUpdate(*this, entity, dt);
+            }
+        };
+        auto post = [this, dt](Entity &entity)
+        {
+            for (System *system : m_postUpdateSystems)
             {
-                for (auto &system : m_systems)
-                {
-                    system->onPostUpdate(*this, entity, dt);
-                }
-            });
+                system->onPostUpdate(*this, entity, dt);
+            }
+        };
+
+        if (!m_preUpdateSystems.empty() && !m_postUpdateSystems.empty())
+        {
+            traverse(pre, post);
+        }
+        else if (!m_preUpdateSystems.empty())
+        {
+            traverse(pre, nullptr);
+        }
+        else if (!m_postUpdateSystems.empty())
+        {
+            traverse(nullptr, post);
+        }
+
+        flushCommands();
     }
 
-    void Scene::traverse(const std::function<void(Entity &)> &pre,
-                         const std::function<void(Entity &)> &post)
+    void Scene::updateWorldTransforms()
     {
-        auto roots = rootEntities();
-        for (const auto &root : roots)
+        // Structural changes only reorder; each entity notices a new parent itself, so spawning
+        // one entity does not recompute every matrix.
+        if (m_worldOrderVersion != m_hierarchyVersion)
         {
-            traverseRecursive(root, pre, post);
+            rebuildWorldOrder();
+        }
+
+        auto *transforms = findStorage<TransformComponent>();
+        auto *worlds = findStorage<WorldTransformComponent>();
+        if (!transforms || !worlds)
+        {
+            return;
+        }
+
+        // Every node is visited: TransformComponent has no write hook, so comparing against the TRS
+        // cached in WorldTransformComponent is the only way to see a change. Clean entities stop
+        // at that compare; compose and the parent multiply only run down dirty subtrees.
+        for (std::size_t i = 0; i < m_worldOrder.size(); ++i)
+        {
+            const WorldTransformEntry &entry = m_worldOrder[i];
+            const TransformComponent *transform = transforms->tryGet(entry.id);
+            WorldTransformComponent *world = worlds->tryGet(entry.id);
+            if (!transform || !world)
+            {
+                m_worldDirty[i] = 1;
+                continue;
+            }
+
+            const bool localChanged = !world->built || !sameVector(world->position, transform->position) ||
+                                      !sameVector(world->rotation, transform->rotation) ||
+                                      !sameVector(world->scale, transform->scale);
+            if (localChanged)
+            {
+                world->local = Matrix4f::compose(transform->position, transform->rotation, transform->scale);
+                world->position = transform->position;
+                world->rotation = transform->rotation;
+                world->scale = transform->scale;
+                world->built = true;
+            }
+
+            const bool hasParent = entry.parent != NoWorldParent;
+            const EntityId parentId = hasParent ? m_worldOrder[entry.parent].id : InvalidEntity;
+            const bool dirty = localChanged || world->parent != parentId || (hasParent && m_worldDirty[entry.parent]);
+            m_worldDirty[i] = dirty ? 1 : 0;
+            if (!dirty)
+            {
+                continue;
+            }
+
+            const WorldTransformComponent *parentWorld = hasParent ? worlds->tryGet(parentId) : nullptr;
+            world->matrix = parentWorld ? parentWorld->matrix * world->local : world->local;
+            world->parent = parentId;
         }
     }
 
+    CommandBuffer &Scene::commands()
+    {
+        return m_commands;
+    }
+
+    void Scene::flushCommands()
+    {
+        m_commands.flush();
+    }
+
     void Scene::addSystem(std::unique_ptr<System> system)
     {
         if (!system)
@@ -179,11 +299,28 @@ namespace Melkam
         }
 
         m_systems.push_back(std::move(system));
+        m_scheduler.invalidate();
     }
 
     void Scene::clearSystems()
     {
         m_systems.clear();
+        m_scheduler.invalidate();
+    }
+
+    void Scene::setThreadPool(ThreadPool *pool)
+    {
+        m_threadPool = pool;
+    }
+
+    ThreadPool *Scene::threadPool() const
+    {
+        return m_threadPool;
+    }
+
+    std::uint64_t Scene::frame() const
+    {
+        return m_frame;
     }
 
     void Scene::setBuilder(Builder builder)
@@ -205,47 +342,205 @@ namespace Melkam
 
     void Scene::clear()
     {
+        m_commands.clear();
+        m_groups.clear();
+        for (const auto &storage : m_components)
+        {
+            m_revisionBase += storage ? storage->revision + 1 : 0;
+        }
         m_components.clear();
-        m_entities.clear();
-        m_entitySet.clear();
         m_systems.clear();
-        m_nextId = InvalidEntity;
+        m_scheduler.invalidate();
+        // After the systems, which may hold context references; a rebuild starts a fresh physics
+        // world instead of inheriting its listeners and solver state.
+        m_context.clear();
+        ++m_hierarchyVersion;
+
+        // Retire every slot instead of resetting, so handles from before the clear stay invalid.
+        m_freeSlots.clear();
+        for (std::uint32_t index = static_cast<std::uint32_t>(m_versions.size()); index-- > 0;)
+        {
+            bumpVersion(index);
+            m_freeSlots.push_back(index);
+        }
     }
 
     bool Scene::isValid(EntityId id) const
     {
-        return m_entitySet.find(id) != m_entitySet.end();
+        const std::uint32_t index = EntityIndex(id);
+        return id != InvalidEntity && index < m_versions.size() && m_versions[index] == EntityVersion(id);
     }
 
-    void Scene::traverseRecursive(Entity entity,
-                                  const std::function<void(Entity &)> &pre,
-                                  const std::function<void(Entity &)> &post)
+    void Scene::prepareSchedule()
     {
-        if (!entity.isValid())
+        m_scheduler.rebuild(m_systems);
+
+        m_preUpdateSystems.clear();
+        m_postUpdateSystems.clear();
+        for (const auto &system : m_systems)
+        {
+            if (system->hasHook(SystemHooks::PreUpdate))
+            {
+                m_preUpdateSystems.push_back(system.get());
+            }
+            if (system->hasHook(SystemHooks::PostUpdate))
+            {
+                m_postUpdateSystems.push_back(system.get());
+            }
+        }
+
+        // Create every declared pool up front so systems running concurrently never grow m_components.
+        for (const auto &system : m_systems)
+        {
+            for (const auto &entry : system->access().entries())
+            {
+                if (entry.type >= m_components.size())
+                {
+                    m_components.resize(entry.type + 1);
+                }
+
+                if (!m_components[entry.type])
+                {
+                    m_components[entry.type] = entry.makeStorage();
+                }
+            }
+        }
+    }
+
+    void Scene::unlinkNode(EntityId id)
+    {
+        auto *node = tryGetComponent<NodeComponent>(id);
+        if (!node)
         {
             return;
         }
 
-        if (pre)
+        if (node->parent != InvalidEntity)
+        {
+            auto *parentNode = tryGetComponent<NodeComponent>(node->parent);
+            if (parentNode)
+            {
+                auto &siblings = parentNode->children;
+                siblings.erase(std::remove(siblings.begin(), siblings.end(), id), siblings.end());
+            }
+        }
+
+        for (EntityId childId : node->children)
+        {
+            auto *childNode = tryGetComponent<NodeComponent>(childId);
+            if (childNode)
+            {
+                childNode->parent = InvalidEntity;
+            }
+        }
+    }
+
+    void Scene::releaseSlot(std::uint32_t index)
+    {
+        bumpVersion(index);
+        m_freeSlots.push_back(index);
+    }
+
+    void Scene::bumpVersion(std::uint32_t index)
+    {
+        // A free slot already carries the version its next occupant gets, so no live handle matches it.
+        if (++m_versions[index] == 0u)
         {
-            pre(entity);
+            m_versions[index] = 1u;
         }
+    }
 
-        const auto *node = tryGetComponent<NodeComponent>(entity.id());
-        if (node)
+    void Scene::rebuildWorldOrder()
+    {
+        m_worldOrder.clear();
+        m_worldOrderVersion = m_hierarchyVersion;
+
+        const auto *nodes = findStorage<NodeComponent>();
+        if (nodes)
         {
-            for (EntityId childId : node->children)
+            const auto &ids = nodes->entities();
+            const NodeComponent *data = nodes->data();
+            for (std::size_t i = 0; i < ids.size(); ++i)
             {
-                if (isValid(childId))
+                if (data[i].parent == InvalidEntity)
+                {
+                    m_worldOrder.push_back({ids[i], NoWorldParent});
+                }
+            }
+
+            // The array doubles as the BFS queue: children are appended behind their level.
+            for (std::size_t i = 0; i < m_worldOrder.size(); ++i)
+            {
+                const auto *node = nodes->tryGet(m_worldOrder[i].id);
+                if (!node)
+                {
+                    continue;
+                }
+
+                for (EntityId child : node->children)
                 {
-                    traverseRecursive(Entity(this, childId), pre, post);
+                    if (isValid(child))
+                    {
+                        m_worldOrder.push_back({child, static_cast<std::uint32_t>(i)});
+                    }
                 }
             }
         }
 
-        if (post)
+        // Parents precede their children, so every flag is written before it is read.
+        m_worldDirty.resize(m_worldOrder.size());
+    }
+
+    const std::vector<Scene::TraversalStep> &Scene::traversalOrder()
+    {
+        // Never rebuild underneath a walk that is still reading the array.
+        if (m_traversalVersion == m_hierarchyVersion || m_traversalDepth > 0)
+        {
+            return m_traversalOrder;
+        }
+
+        m_traversalOrder.clear();
+        m_traversalVersion = m_hierarchyVersion;
+
+        const auto *nodes = findStorage<NodeComponent>();
+        if (!nodes)
         {
-            post(entity);
+            return m_traversalOrder;
         }
+
+        const auto &ids = nodes->entities();
+        const NodeComponent *data = nodes->data();
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            if (data[i].parent != InvalidEntity)
+            {
+                continue;
+            }
+
+            m_traversalOrder.push_back({ids[i], false});
+            m_traversalStack.emplace_back(ids[i], 0);
+            while (!m_traversalStack.empty())
+            {
+                const EntityId current = m_traversalStack.back().first;
+                const std::size_t next = m_traversalStack.back().second;
+                const auto *node = tryGetComponent<NodeComponent>(current);
+                if (node && next < node->children.size())
+                {
+                    ++m_traversalStack.back().second;
+                    const EntityId child = node->children[next];
+                    if (isValid(child))
+                    {
+                        m_traversalOrder.push_back({child, false});
+                        m_traversalStack.emplace_back(child, 0);
+                    }
+                    continue;
+                }
+
+                m_traversalOrder.push_back({current, true});
+                m_traversalStack.pop_back();
+            }
+        }
+
+        return m_traversalOrder;
     }
 }
@@ -0,0 +1,99 @@
+#include <Melkam/scene/SystemScheduler.hpp>
+
+#include <Melkam/core/ThreadPool.hpp>
+#include <Melkam/scene/Scene.hpp>
+#include <Melkam/scene/System.hpp>
+
+namespace Melkam
+{
+    void SystemScheduler::invalidate()
+    {
+        m_dirty = true;
+    }
+
+    bool SystemScheduler::dirty() const
+    {
+        return m_dirty;
+    }
+
+    void SystemScheduler::rebuild(const std::vector<std::unique_ptr<System>> &systems)
+    {
+        m_stages.clear();
+
+        // Systems without an onUpdate override take no stage; stageOf stays 0 and they are never compared.
+        std::vector<std::size_t> stageOf(systems.size(), 0);
+        for (std::size_t i = 0; i < systems.size(); ++i)
+        {
+            if (!systems[i]->hasHook(SystemHooks::Update))
+            {
+                continue;
+            }
+
+            std::size_t stage = 0;
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                if (!systems[j]->hasHook(SystemHooks::Update))
+                {
+                    continue;
+                }
+
+                if (stageOf[j] + 1 > stage && systems[i]->access().conflictsWith(systems[j]->access()))
+                {
+                    stage = stageOf[j] + 1;
+                }
+            }
+
+            stageOf[i] = stage;
+            if (stage >= m_stages.size())
+            {
+                m_stages.resize(stage + 1);
+            }
+
+            m_stages[stage].members.push_back(i);
+            if (systems[i]->access().mainThread())
+            {
+                ++m_stages[stage].mainThreadCount;
+            }
+        }
+
+        m_dirty = false;
+    }
+
+    void SystemScheduler::run(Scene &scene, const std::vector<std::unique_ptr<System>> &systems, ThreadPool *pool, float dt)
+    {
+        const bool parallel = pool && pool->workerCount() > 0;
+        for (const auto &stage : m_stages)
+        {
+            const std::size_t offloadable = stage.members.size() - stage.mainThreadCount;
+            if (!parallel || offloadable == 0 || stage.members.size() == 1)
+            {
+                for (std::size_t index : stage.members)
+                {
+                    systems[index]->onUpdate(scene, dt);
+                }
+                continue;
+            }
+
+            ThreadPool::TaskGroup group;
+            for (std::size_t index : stage.members)
+            {
+                if (!systems[index]->access().mainThread())
+                {
+                    System *system = systems[index].get();
+                    pool->submit(group, [system, &scene, dt]()
+                                 { system->onUpdate(scene, dt); });
+                }
+            }
+
+            for (std::size_t index : stage.members)
+            {
+                if (systems[index]->access().mainThread())
+                {
+                    systems[index]->onUpdate(scene, dt);
+                }
+            }
+
+            pool->wait(group);
+        }
+    }
+}
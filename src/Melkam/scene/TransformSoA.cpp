@@ -0,0 +1,151 @@
+#include <Melkam/scene/TransformSoA.hpp>
+
+#include <Melkam/math/SimdKernels.hpp>
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Scene.hpp>
+#include <Melkam/scene/System.hpp>
+
+namespace Melkam
+{
+    namespace
+    {
+        class BatchIntegrationSystem : public System
+        {
+        public:
+            BatchIntegrationSystem()
+            {
+                declareAccess()
+                    .write<TransformComponent>()
+                    .read<Velocity2DComponent, Velocity3DComponent, ColliderComponent, BoxShape2DComponent, BoxShape3DComponent>();
+            }
+
+            void onUpdate(Scene &scene, float dt) override
+            {
+                m_pool.gather(scene);
+                m_pool.integrate(dt);
+                m_pool.scatter(scene);
+            }
+
+        private:
+            // Kept between frames so the arrays are only reallocated when the set grows.
+            TransformSoA m_pool;
+        };
+    }
+
+    void TransformSoA::reserve(std::size_t capacity)
+    {
+        m_ids.reserve(capacity);
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            m_position[axis].reserve(capacity);
+            m_velocity[axis].reserve(capacity);
+            m_half[axis].reserve(capacity);
+        }
+    }
+
+    void TransformSoA::clear()
+    {
+        m_ids.clear();
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            m_position[axis].clear();
+            m_velocity[axis].clear();
+            m_half[axis].clear();
+            m_min[axis].clear();
+            m_max[axis].clear();
+        }
+    }
+
+    std::size_t TransformSoA::add(EntityId id, const Vector3f &position, const Vector3f &velocity, const Vector3f &halfExtents)
+    {
+        const float p[3] = {position.x, position.y, position.z};
+        const float v[3] = {velocity.x, velocity.y, velocity.z};
+        const float h[3] = {halfExtents.x, halfExtents.y, halfExtents.z};
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            m_position[axis].push_back(p[axis]);
+            m_velocity[axis].push_back(v[axis]);
+            m_half[axis].push_back(h[axis]);
+        }
+
+        m_ids.push_back(id);
+        return m_ids.size() - 1;
+    }
+
+    void TransformSoA::gather(Scene &scene)
+    {
+        clear();
+
+        auto view3D = scene.view<TransformComponent, Velocity3DComponent>();
+        auto view2D = scene.view<TransformComponent, Velocity2DComponent>();
+        reserve(view3D.sizeHint() + view2D.sizeHint());
+
+        view3D.each([&](Entity entity, TransformComponent &transform, Velocity3DComponent &velocity)
+                    {
+                        if (scene.hasComponent<ColliderComponent>(entity.id()))
+                        {
+                            return;
+                        }
+
+                        Vector3f half{0.5f, 0.5f, 0.5f};
+                        if (const auto *box = scene.tryGetComponent<BoxShape3DComponent>(entity.id()))
+                        {
+                            half = {box->size[0] * 0.5f, box->size[1] * 0.5f, box->size[2] * 0.5f};
+                        }
+                        add(entity.id(), transform.position, {velocity.velocity[0], velocity.velocity[1], velocity.velocity[2]}, half);
+                    });
+
+        // An entity carrying both velocity components is integrated once, as 3D.
+        view2D.each([&](Entity entity, TransformComponent &transform, Velocity2DComponent &velocity)
+                    {
+                        // Collider-less boxes are still moved and slid by Physics2DSystem.
+                        const EntityId id = entity.id();
+                        if (scene.hasComponent<Velocity3DComponent>(id) || scene.hasComponent<ColliderComponent>(id) ||
+                            scene.hasComponent<BoxShape2DComponent>(id))
+                        {
+                            return;
+                        }
+
+                        add(id, transform.position, {velocity.velocity[0], velocity.velocity[1], 0.0f}, {0.5f, 0.5f, 0.0f});
+                    });
+    }
+
+    void TransformSoA::scatter(Scene &scene) const
+    {
+        for (std::size_t i = 0; i < m_ids.size(); ++i)
+        {
+            if (m_ids[i] == InvalidEntity)
+            {
+                continue;
+            }
+
+            if (auto *transform = scene.tryGetComponent<TransformComponent>(m_ids[i]))
+            {
+                transform->position = {m_position[0][i], m_position[1][i], m_position[2][i]};
+            }
+        }
+    }
+
+    void TransformSoA::integrate(float dt)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            IntegrateAxis(m_position[axis].data(), m_velocity[axis].data(), m_ids.size(), dt);
+        }
+    }
+
+    void TransformSoA::buildAabbs()
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            m_min[axis].resize(m_ids.size());
+            m_max[axis].resize(m_ids.size());
+            BuildBounds(m_position[axis].data(), m_half[axis].data(), m_min[axis].data(), m_max[axis].data(), m_ids.size());
+        }
+    }
+
+    void RegisterBatchIntegrationSystem(Scene &scene)
+    {
+        scene.createSystem<BatchIntegrationSystem>();
+    }
+}
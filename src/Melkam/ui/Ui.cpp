@@ -1067,6 +1067,12 @@ namespace Melkam
         class UiRenderSystem : public System
         {
         public:
+            UiRenderSystem()
+            {
+                // No declared access: button callbacks may touch any component, so this runs alone.
+                declareAccess().pinToMainThread();
+            }
+
             void onUpdate(Scene &scene, float dt) override
             {
                 (void)dt;
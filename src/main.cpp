@@ -65,9 +65,9 @@ public:
                     transform->rotation.y = atan2f(moveDir.x, moveDir.z);
                 }
             }
-
-            MoveAndSlide3D(entity, dt);
         }
+
+        MoveAndSlideCharacters3D(scene, dt);
     }
 };
 
@@ -0,0 +1,72 @@
+// Regression checks for the raylib-free physics core. Built by the PhysicsTests target and run
+// with ctest; every check prints its name and the program exits non-zero if any failed.
+
+#include <Melkam/physics/PhysicsWorld.hpp>
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+
+#include <cstdio>
+
+using namespace Melkam;
+
+namespace
+{
+    int g_failures = 0;
+
+    void check(bool condition, const char *name)
+    {
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", name);
+        if (!condition)
+        {
+            ++g_failures;
+        }
+    }
+
+    int hits3D(PhysicsWorld &world, const Aabb3D &box)
+    {
+        int count = 0;
+        world.query3D(box, 0xFFFFFFFFu, 0xFFFFFFFFu,
+                      [&count](EntityId, const Aabb3D &)
+                      {
+                          ++count;
+                      });
+        return count;
+    }
+
+    Entity makeBox3D(Scene &scene, const Vector3f &position)
+    {
+        Entity entity = scene.createEntity("Box");
+        entity.addComponent<TransformComponent>().position = position;
+        auto &shape = entity.addComponent<BoxShape3DComponent>();
+        shape.size[0] = shape.size[1] = shape.size[2] = 2.0f;
+        return entity;
+    }
+
+    // The static BVH is baked on the first sync; a static body that only becomes a collider
+    // afterwards must still be baked into it.
+    void colliderAddedToExistingStaticBody()
+    {
+        Scene scene("Statics");
+        PhysicsWorld &world = PhysicsWorld::get(scene);
+
+        Entity wall = makeBox3D(scene, {5.0f, 0.0f, 0.0f});
+        wall.addComponent<StaticBody3DComponent>();
+        Entity other = makeBox3D(scene, {-5.0f, 0.0f, 0.0f});
+        other.addComponent<StaticBody3DComponent>();
+        other.addComponent<ColliderComponent>().is2D = false;
+        world.sync(scene);
+        check(hits3D(world, {4.0f, -1.0f, -1.0f, 6.0f, 1.0f, 1.0f}) == 0, "static body without a collider is not baked");
+
+        wall.addComponent<ColliderComponent>().is2D = false;
+        world.sync(scene);
+        check(hits3D(world, {4.0f, -1.0f, -1.0f, 6.0f, 1.0f, 1.0f}) == 1, "collider added to an existing static body is baked");
+        check(hits3D(world, {-6.0f, -1.0f, -1.0f, -4.0f, 1.0f, 1.0f}) == 1, "earlier static stays baked");
+    }
+}
+
+int main()
+{
+    colliderAddedToExistingStaticBody();
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+// Checks for the SoA batch integration path. Built by the TransformSoATests target and run
+// with ctest; every check prints its name and the program exits non-zero if any failed.
+
+#include <Melkam/scene/Components.hpp>
+#include <Melkam/scene/Entity.hpp>
+#include <Melkam/scene/Scene.hpp>
+#include <Melkam/scene/TransformSoA.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using namespace Melkam;
+
+namespace
+{
+    int g_failures = 0;
+
+    void check(bool condition, const char *name)
+    {
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", name);
+        if (!condition)
+        {
+            ++g_failures;
+        }
+    }
+
+    // Per-entity reference, rounded the same way as the kernels' scalar tail.
+    Vector3f integrated(Vector3f position, const float velocity[3], int axes, float dt)
+    {
+        position.x = position.x + velocity[0] * dt;
+        position.y = position.y + velocity[1] * dt;
+        if (axes == 3)
+        {
+            position.z = position.z + velocity[2] * dt;
+        }
+        return position;
+    }
+
+    bool samePosition(const Vector3f &a, const Vector3f &b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    // Counts that are not multiples of the vector width, so the scalar tail runs too.
+    void systemMatchesPerEntityIntegration()
+    {
+        Scene scene("Batch");
+        RegisterBatchIntegrationSystem(scene);
+
+        struct Expected
+        {
+            Entity entity;
+            Vector3f position;
+            float velocity[3];
+            int axes;
+        };
+        std::vector<Expected> expected;
+
+        for (int i = 0; i < 37; ++i)
+        {
+            Entity entity = scene.createEntity("Particle3D");
+            const Vector3f position{i * 0.37f, -i * 1.1f, 3.0f + i * 0.013f};
+            entity.addComponent<TransformComponent>().position = position;
+            auto &velocity = entity.addComponent<Velocity3DComponent>();
+            velocity.velocity[0] = 1.5f + i * 0.1f;
+            velocity.velocity[1] = -9.81f * i;
+            velocity.velocity[2] = 0.3f - i * 0.07f;
+            expected.push_back({entity, position, {velocity.velocity[0], velocity.velocity[1], velocity.velocity[2]}, 3});
+        }
+
+        for (int i = 0; i < 13; ++i)
+        {
+            Entity entity = scene.createEntity("Particle2D");
+            const Vector3f position{100.0f - i * 3.3f, i * 0.9f, 0.0f};
+            entity.addComponent<TransformComponent>().position = position;
+            auto &velocity = entity.addComponent<Velocity2DComponent>();
+            velocity.velocity[0] = -40.0f + i * 7.1f;
+            velocity.velocity[1] = 12.5f * i;
+            expected.push_back({entity, position, {velocity.velocity[0], velocity.velocity[1], 0.0f}, 2});
+        }
+
+        // Left to the physics systems, so the batch must not move them.
+        Entity collider = scene.createEntity("Collider");
+        collider.addComponent<TransformComponent>().position = {1.0f, 2.0f, 3.0f};
+        collider.addComponent<Velocity3DComponent>().velocity[0] = 5.0f;
+        collider.addComponent<ColliderComponent>().is2D = false;
+
+        Entity bareMover = scene.createEntity("BareMover");
+        bareMover.addComponent<TransformComponent>().position = {4.0f, 5.0f, 0.0f};
+        bareMover.addComponent<Velocity2DComponent>().velocity[0] = 5.0f;
+        bareMover.addComponent<BoxShape2DComponent>();
+
+        const float steps[] = {1.0f / 60.0f, 1.0f / 30.0f, 0.0123f, 1.0f / 144.0f};
+        for (int frame = 0; frame < 12; ++frame)
+        {
+            const float dt = steps[frame % 4];
+            scene.update(dt);
+            for (Expected &entry : expected)
+            {
+                entry.position = integrated(entry.position, entry.velocity, entry.axes, dt);
+            }
+        }
+
+        bool same = true;
+        for (const Expected &entry : expected)
+        {
+            same = same && samePosition(entry.entity.tryGetComponent<TransformComponent>()->position, entry.position);
+        }
+        check(same, "batch integration matches per-entity integration bit for bit");
+        check(samePosition(collider.tryGetComponent<TransformComponent>()->position, {1.0f, 2.0f, 3.0f}), "collider bodies are left to physics");
+        check(samePosition(bareMover.tryGetComponent<TransformComponent>()->position, {4.0f, 5.0f, 0.0f}), "bare 2D movers are left to physics");
+    }
+
+    void aabbsMatchPerSlotBounds()
+    {
+        TransformSoA pool;
+        for (int i = 0; i < 21; ++i)
+        {
+            pool.add(InvalidEntity, {i * 0.5f, -i * 0.25f, i * 1.75f}, {}, {0.5f + i * 0.1f, 1.0f, 0.25f * i});
+        }
+        pool.buildAabbs();
+
+        bool same = true;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            for (std::size_t i = 0; i < pool.size(); ++i)
+            {
+                const float center = pool.position(axis)[i];
+                const float half = pool.halfExtents(axis)[i];
+                same = same && pool.aabbMin(axis)[i] == center - half && pool.aabbMax(axis)[i] == center + half;
+            }
+        }
+        check(same, "batch bounds match per-slot bounds");
+    }
+}
+
+int main()
+{
+    systemMatchesPerEntityIntegration();
+    aabbsMatchPerSlotBounds();
+    return g_failures == 0 ? 0 : 1;
+}